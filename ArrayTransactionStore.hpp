@@ -1,40 +1,233 @@
 #ifndef ARRAYTRANSACTIONSTORE_HPP
 #define ARRAYTRANSACTIONSTORE_HPP
 
+#include <new>
+#include <utility>
 #include "Transaction.hpp"
+#include "MemoryUsage.hpp"
+#include "TransactionTypeIndex.hpp"
+#include "SortIndex.hpp"
+#include "NumericFilter.hpp"
 
-#define MAX_TRANSACTIONS 500000
-
+// Contiguous, heap-backed store that grows geometrically. Only the first
+// count slots hold constructed Transactions; the rest is raw capacity.
+// Rows stay in insertion order; sorting installs a SortIndex view instead.
 class ArrayTransactionStore
 {
 private:
-    Transaction transactions[MAX_TRANSACTIONS];
+    Transaction *transactions;
     int count;
+    int capacity;
+    AllocationCounter allocations; // the row buffer
+    mutable TransactionTypeIndex<int> typeIndex;
+    mutable bool typeIndexStale;
+    mutable PackedNumericColumns numericColumns;
+    mutable bool numericColumnsStale;
+    SortIndex view;
+
+    void reallocate(int newCapacity)
+    {
+        Transaction *resized = newCapacity > 0
+                                   ? static_cast<Transaction *>(::operator new(sizeof(Transaction) * newCapacity))
+                                   : nullptr;
+        for (int i = 0; i < count; ++i)
+        {
+            new (&resized[i]) Transaction(std::move(transactions[i]));
+            transactions[i].~Transaction();
+        }
+        if (resized)
+            allocations.allocated(sizeof(Transaction) * newCapacity);
+        ::operator delete(transactions);
+        allocations.released(sizeof(Transaction) * capacity);
+        transactions = resized;
+        capacity = newCapacity;
+    }
+
+    // Rows were added or modified in place: the view no longer matches them.
+    void invalidate()
+    {
+        typeIndexStale = true;
+        numericColumnsStale = true;
+        if (!view.isInsertionOrder())
+            view.clear();
+    }
+
+    void growFor(int needed)
+    {
+        if (needed > capacity)
+            reallocate(needed > capacity * 2 ? needed : (capacity < 8 ? 8 : capacity * 2));
+    }
 
 public:
-    ArrayTransactionStore() : count(0) {}
+    ArrayTransactionStore() : transactions(nullptr), count(0), capacity(0), typeIndexStale(true), numericColumnsStale(true) {}
+    ~ArrayTransactionStore()
+    {
+        clear();
+        ::operator delete(transactions);
+    }
+
+    ArrayTransactionStore(const ArrayTransactionStore &other)
+        : transactions(nullptr), count(0), capacity(0), typeIndexStale(true), numericColumnsStale(true)
+    {
+        reserve(other.count);
+        for (int i = 0; i < other.count; ++i)
+            add(other.transactions[i]);
+        view = other.view;
+    }
+
+    ArrayTransactionStore(ArrayTransactionStore &&other) noexcept
+        : transactions(other.transactions), count(other.count), capacity(other.capacity),
+          allocations(other.allocations), typeIndex(std::move(other.typeIndex)), typeIndexStale(other.typeIndexStale),
+          numericColumns(std::move(other.numericColumns)), numericColumnsStale(other.numericColumnsStale),
+          view(std::move(other.view))
+    {
+        other.transactions = nullptr;
+        other.count = other.capacity = 0;
+        other.allocations = AllocationCounter();
+        other.typeIndexStale = true;
+        other.numericColumnsStale = true;
+    }
+
+    ArrayTransactionStore &operator=(ArrayTransactionStore other) noexcept
+    {
+        std::swap(transactions, other.transactions);
+        std::swap(count, other.count);
+        std::swap(capacity, other.capacity);
+        std::swap(allocations, other.allocations);
+        std::swap(typeIndex, other.typeIndex);
+        std::swap(typeIndexStale, other.typeIndexStale);
+        std::swap(numericColumns, other.numericColumns);
+        std::swap(numericColumnsStale, other.numericColumnsStale);
+        view.swap(other.view);
+        return *this;
+    }
 
     void add(const Transaction &t)
     {
-        if (count < MAX_TRANSACTIONS)
-            transactions[count++] = t;
+        growFor(count + 1);
+        new (&transactions[count]) Transaction(t);
+        count++;
+        invalidate();
     }
 
-    void swap(int i, int j)
+    void add(Transaction &&t)
     {
-        if (i >= 0 && j >= 0 && i < count && j < count)
-        {
-            Transaction temp = transactions[i];
-            transactions[i] = transactions[j];
-            transactions[j] = temp;
-        }
+        growFor(count + 1);
+        new (&transactions[count]) Transaction(std::move(t));
+        count++;
+        invalidate();
+    }
+
+    // Makes room for at least n rows without further reallocation.
+    void reserve(int n)
+    {
+        if (n > capacity)
+            reallocate(n);
+    }
+
+    // Releases the unused tail of the buffer.
+    void shrinkToFit()
+    {
+        if (capacity > count)
+            reallocate(count);
     }
 
     int size() const { return count; }
+    int getCapacity() const { return capacity; }
     Transaction get(int index) const { return transactions[index]; }
     const Transaction &getRef(int index) const { return transactions[index]; }
-    Transaction &getRef(int index) { return transactions[index]; }
-    void clear() { count = 0; }
+    // Writable row: the caller may change any field, so the sort view is
+    // dropped and the indexes go stale.
+    Transaction &mutableRef(int index)
+    {
+        invalidate();
+        return transactions[index];
+    }
+
+    // Row positions per transaction_type code; rebuilt on first use after
+    // any change that can move or alter rows.
+    const TransactionTypeIndex<int> &getTypeIndex() const
+    {
+        if (typeIndexStale)
+            rebuildTypeIndex();
+        return typeIndex;
+    }
+
+    void rebuildTypeIndex() const
+    {
+        typeIndex.clear();
+        for (int i = 0; i < count; ++i)
+            typeIndex.add(transactions[i].transaction_type, i);
+        typeIndexStale = false;
+    }
+
+    // amount, velocity_score, geo_anomaly_score and is_fraud packed into
+    // columns in row order for the vectorized filters; built on first use
+    // after any change to the rows.
+    NumericColumnView getNumericColumns() const
+    {
+        if (numericColumnsStale)
+        {
+            numericColumns.clear();
+            numericColumns.reserve(count);
+            for (int i = 0; i < count; ++i)
+                numericColumns.add(transactions[i]);
+            numericColumnsStale = false;
+        }
+        return numericColumns.view();
+    }
+
+    // Row shown at position of the current view.
+    int rowAt(int position) const { return view.rowAt(position); }
+    const SortIndex &getSortIndex() const { return view; }
+
+    // Counted allocations of the row buffer, live and at peak.
+    const AllocationCounter &getAllocations() const { return allocations; }
+    void resetAllocationPeak() { allocations.resetPeak(); }
+
+    // Heap bytes owned by the store: the row buffer, the strings' heap data,
+    // the type index, the numeric columns and the view.
+    size_t footprintBytes() const
+    {
+        size_t total = (size_t)allocations.liveBytes() + typeIndex.bytes() + numericColumns.bytes() + view.bytes();
+        for (int i = 0; i < count; ++i)
+            total += stringHeapBytes(transactions[i]);
+        return total;
+    }
+
+    // Installs index as the view and hands back the previous one.
+    void swapSortIndex(SortIndex &index) { view.swap(index); }
+    void clearSortIndex() { view.clear(); }
+
+    // View positions [first, last) whose key equals code, found by binary
+    // search. Returns false, with an empty range, unless the view is sorted
+    // on key first.
+    bool equalRange(SortKey key, int code, int &first, int &last) const
+    {
+        first = last = 0;
+        const vector<SortField> &fields = view.getFields();
+        if (fields.empty() || fields[0].key != key)
+            return false;
+        if (code < 0)
+            return true;
+        const vector<int> &ranks = sortKeyRanks(key);
+        equalRankRange(count, ranks[code], fields[0].ascending, [&](int i)
+                       { return ranks[sortKeyCode(transactions[view.rowAt(i)], key)]; }, first, last);
+        return true;
+    }
+
+    // Destroys every row but keeps the buffer for reuse.
+    void clear()
+    {
+        for (int i = 0; i < count; ++i)
+            transactions[i].~Transaction();
+        count = 0;
+        typeIndex.clear();
+        typeIndexStale = true;
+        numericColumns.clear();
+        numericColumnsStale = true;
+        view.clear();
+    }
 };
 
-#endif
\ No newline at end of file
+#endif
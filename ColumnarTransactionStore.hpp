@@ -0,0 +1,280 @@
+#ifndef COLUMNARTRANSACTIONSTORE_HPP
+#define COLUMNARTRANSACTIONSTORE_HPP
+
+#include <vector>
+#include <utility>
+#include "Transaction.hpp"
+#include "MemoryUsage.hpp"
+#include "TransactionTypeIndex.hpp"
+#include "SortIndex.hpp"
+#include "NumericFilter.hpp"
+
+// Struct-of-arrays store: every Transaction field lives in its own contiguous
+// column, so a scan over one field never drags the rest of the record through
+// the cache. Sorting installs a SortIndex view; the columns keep insertion
+// order.
+class ColumnarTransactionStore
+{
+private:
+    // Every column allocates through it; declared first so it outlives them.
+    AllocationCounter allocations;
+    CountedVector<string> transactionIds;
+    CountedVector<string> timestamps;
+    CountedVector<string> senderAccounts;
+    CountedVector<string> receiverAccounts;
+    CountedVector<double> amounts;
+    CountedVector<DictCode> transactionTypes;
+    CountedVector<DictCode> merchantCategories;
+    CountedVector<DictCode> locations;
+    CountedVector<DictCode> devicesUsed;
+    CountedVector<unsigned char> fraudFlags;
+    CountedVector<DictCode> fraudTypes;
+    CountedVector<string> timesSinceLastTransaction;
+    CountedVector<string> spendingDeviationScores;
+    CountedVector<double> velocityScores;
+    CountedVector<double> geoAnomalyScores;
+    CountedVector<DictCode> paymentChannels;
+    CountedVector<string> ipAddresses;
+    CountedVector<string> deviceHashes;
+    mutable TransactionTypeIndex<int> typeIndex;
+    mutable bool typeIndexStale = true;
+    SortIndex view;
+
+    CountingAllocator<char> counting() { return CountingAllocator<char>(&allocations); }
+
+    // Rows were added: the view no longer matches them.
+    void invalidate()
+    {
+        typeIndexStale = true;
+        if (!view.isInsertionOrder())
+            view.clear();
+    }
+
+    // Appends every field of t to its column; the string fields are moved
+    // when t is an rvalue.
+    template <typename T>
+    void append(T &&t)
+    {
+        transactionIds.push_back(std::forward<T>(t).transaction_id);
+        timestamps.push_back(std::forward<T>(t).timestamp);
+        senderAccounts.push_back(std::forward<T>(t).sender_account);
+        receiverAccounts.push_back(std::forward<T>(t).receiver_account);
+        amounts.push_back(t.amount);
+        transactionTypes.push_back(t.transaction_type);
+        merchantCategories.push_back(t.merchant_category);
+        locations.push_back(t.location);
+        devicesUsed.push_back(t.device_used);
+        fraudFlags.push_back(t.is_fraud ? 1 : 0);
+        fraudTypes.push_back(t.fraud_type);
+        timesSinceLastTransaction.push_back(std::forward<T>(t).time_since_last_transaction);
+        spendingDeviationScores.push_back(std::forward<T>(t).spending_deviation_score);
+        velocityScores.push_back(t.velocity_score);
+        geoAnomalyScores.push_back(t.geo_anomaly_score);
+        paymentChannels.push_back(t.payment_channel);
+        ipAddresses.push_back(std::forward<T>(t).ip_address);
+        deviceHashes.push_back(std::forward<T>(t).device_hash);
+        invalidate();
+    }
+
+public:
+    ColumnarTransactionStore()
+        : transactionIds(counting()),
+          timestamps(counting()),
+          senderAccounts(counting()),
+          receiverAccounts(counting()),
+          amounts(counting()),
+          transactionTypes(counting()),
+          merchantCategories(counting()),
+          locations(counting()),
+          devicesUsed(counting()),
+          fraudFlags(counting()),
+          fraudTypes(counting()),
+          timesSinceLastTransaction(counting()),
+          spendingDeviationScores(counting()),
+          velocityScores(counting()),
+          geoAnomalyScores(counting()),
+          paymentChannels(counting()),
+          ipAddresses(counting()),
+          deviceHashes(counting())
+    {
+    }
+
+    // The columns report to this store's counter, so a copy could not keep
+    // its own count.
+    ColumnarTransactionStore(const ColumnarTransactionStore &) = delete;
+    ColumnarTransactionStore &operator=(const ColumnarTransactionStore &) = delete;
+
+    void add(const Transaction &t) { append(t); }
+    void add(Transaction &&t) { append(std::move(t)); }
+
+    // Makes room for at least n rows in every column.
+    void reserve(int n)
+    {
+        transactionIds.reserve(n);
+        timestamps.reserve(n);
+        senderAccounts.reserve(n);
+        receiverAccounts.reserve(n);
+        amounts.reserve(n);
+        transactionTypes.reserve(n);
+        merchantCategories.reserve(n);
+        locations.reserve(n);
+        devicesUsed.reserve(n);
+        fraudFlags.reserve(n);
+        fraudTypes.reserve(n);
+        timesSinceLastTransaction.reserve(n);
+        spendingDeviationScores.reserve(n);
+        velocityScores.reserve(n);
+        geoAnomalyScores.reserve(n);
+        paymentChannels.reserve(n);
+        ipAddresses.reserve(n);
+        deviceHashes.reserve(n);
+    }
+
+    // Reassembles a full row; only use this when every field is needed.
+    Transaction get(int index) const
+    {
+        Transaction t;
+        t.transaction_id = transactionIds[index];
+        t.timestamp = timestamps[index];
+        t.sender_account = senderAccounts[index];
+        t.receiver_account = receiverAccounts[index];
+        t.amount = amounts[index];
+        t.transaction_type = transactionTypes[index];
+        t.merchant_category = merchantCategories[index];
+        t.location = locations[index];
+        t.device_used = devicesUsed[index];
+        t.is_fraud = fraudFlags[index] != 0;
+        t.fraud_type = fraudTypes[index];
+        t.time_since_last_transaction = timesSinceLastTransaction[index];
+        t.spending_deviation_score = spendingDeviationScores[index];
+        t.velocity_score = velocityScores[index];
+        t.geo_anomaly_score = geoAnomalyScores[index];
+        t.payment_channel = paymentChannels[index];
+        t.ip_address = ipAddresses[index];
+        t.device_hash = deviceHashes[index];
+        return t;
+    }
+
+    int size() const { return (int)transactionIds.size(); }
+
+    const CountedVector<string> &getTransactionIdColumn() const { return transactionIds; }
+    const CountedVector<string> &getTimestampColumn() const { return timestamps; }
+    const CountedVector<string> &getSenderAccountColumn() const { return senderAccounts; }
+    const CountedVector<string> &getReceiverAccountColumn() const { return receiverAccounts; }
+    const CountedVector<double> &getAmountColumn() const { return amounts; }
+    const CountedVector<DictCode> &getTransactionTypeColumn() const { return transactionTypes; }
+    const CountedVector<DictCode> &getMerchantCategoryColumn() const { return merchantCategories; }
+    const CountedVector<DictCode> &getLocationColumn() const { return locations; }
+    const CountedVector<DictCode> &getDeviceUsedColumn() const { return devicesUsed; }
+    const CountedVector<unsigned char> &getFraudFlagColumn() const { return fraudFlags; }
+    const CountedVector<DictCode> &getFraudTypeColumn() const { return fraudTypes; }
+    const CountedVector<string> &getTimeSinceLastTransactionColumn() const { return timesSinceLastTransaction; }
+    const CountedVector<string> &getSpendingDeviationScoreColumn() const { return spendingDeviationScores; }
+    const CountedVector<double> &getVelocityScoreColumn() const { return velocityScores; }
+    const CountedVector<double> &getGeoAnomalyScoreColumn() const { return geoAnomalyScores; }
+    const CountedVector<DictCode> &getPaymentChannelColumn() const { return paymentChannels; }
+    const CountedVector<string> &getIpAddressColumn() const { return ipAddresses; }
+    const CountedVector<string> &getDeviceHashColumn() const { return deviceHashes; }
+
+    // The numeric columns themselves; nothing to build.
+    NumericColumnView getNumericColumns() const
+    {
+        return NumericColumnView{amounts.data(), velocityScores.data(), geoAnomalyScores.data(),
+                                 fraudFlags.data(), size()};
+    }
+
+    const CountedVector<DictCode> &getKeyColumn(SortKey key) const
+    {
+        return key == SORT_KEY_TRANSACTION_TYPE ? transactionTypes : locations;
+    }
+
+    // Row positions per transaction_type code; rebuilt on first use after
+    // any change that can move or alter rows.
+    const TransactionTypeIndex<int> &getTypeIndex() const
+    {
+        if (typeIndexStale)
+            rebuildTypeIndex();
+        return typeIndex;
+    }
+
+    void rebuildTypeIndex() const
+    {
+        typeIndex.clear();
+        for (int i = 0; i < size(); ++i)
+            typeIndex.add(transactionTypes[i], i);
+        typeIndexStale = false;
+    }
+
+    // Row shown at position of the current view.
+    int rowAt(int position) const { return view.rowAt(position); }
+    const SortIndex &getSortIndex() const { return view; }
+
+    // Counted allocations of the column buffers, live and at peak.
+    const AllocationCounter &getAllocations() const { return allocations; }
+    void resetAllocationPeak() { allocations.resetPeak(); }
+
+    // Heap bytes owned by the store: every column buffer at its capacity,
+    // the heap data of the string columns, the type index and the view.
+    size_t footprintBytes() const
+    {
+        size_t total = (size_t)allocations.liveBytes() + typeIndex.bytes() + view.bytes();
+        const CountedVector<string> *stringColumns[] = {&transactionIds, &timestamps, &senderAccounts, &receiverAccounts,
+                                                        &timesSinceLastTransaction, &spendingDeviationScores,
+                                                        &ipAddresses, &deviceHashes};
+        for (const CountedVector<string> *column : stringColumns)
+        {
+            for (const string &value : *column)
+                total += stringHeapBytes(value);
+        }
+        return total;
+    }
+
+    // Installs index as the view and hands back the previous one.
+    void swapSortIndex(SortIndex &index) { view.swap(index); }
+    void clearSortIndex() { view.clear(); }
+
+    // View positions [first, last) whose key equals code, found by binary
+    // search over the key column. Returns false, with an empty range, unless
+    // the view is sorted on key first.
+    bool equalRange(SortKey key, int code, int &first, int &last) const
+    {
+        first = last = 0;
+        const vector<SortField> &fields = view.getFields();
+        if (fields.empty() || fields[0].key != key)
+            return false;
+        if (code < 0)
+            return true;
+        const vector<int> &ranks = sortKeyRanks(key);
+        const CountedVector<DictCode> &keys = getKeyColumn(key);
+        equalRankRange(size(), ranks[code], fields[0].ascending, [&](int i)
+                       { return ranks[keys[view.rowAt(i)]]; }, first, last);
+        return true;
+    }
+
+    void clear()
+    {
+        transactionIds.clear();
+        timestamps.clear();
+        senderAccounts.clear();
+        receiverAccounts.clear();
+        amounts.clear();
+        transactionTypes.clear();
+        merchantCategories.clear();
+        locations.clear();
+        devicesUsed.clear();
+        fraudFlags.clear();
+        fraudTypes.clear();
+        timesSinceLastTransaction.clear();
+        spendingDeviationScores.clear();
+        velocityScores.clear();
+        geoAnomalyScores.clear();
+        paymentChannels.clear();
+        ipAddresses.clear();
+        deviceHashes.clear();
+        typeIndex.clear();
+        typeIndexStale = true;
+        view.clear();
+    }
+};
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef CSVFIELDSPLITTER_HPP
+#define CSVFIELDSPLITTER_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <string_view>
+#include <charconv>
+#include <system_error>
+using namespace std;
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define CSV_SPLITTER_X86 1
+#endif
+
+typedef int (*CommaFinder)(const char *data, size_t length, size_t *offsets, int maxCommas);
+
+// Records the offsets of the first maxCommas commas in data and returns how
+// many were found. All variants produce identical results.
+inline int findCommasScalar(const char *data, size_t length, size_t *offsets, int maxCommas)
+{
+    int found = 0;
+    for (size_t i = 0; i < length && found < maxCommas; ++i)
+    {
+        if (data[i] == ',')
+            offsets[found++] = i;
+    }
+    return found;
+}
+
+#ifdef CSV_SPLITTER_X86
+// Compares 16 bytes at a time and walks the resulting bit mask.
+__attribute__((target("sse2"))) inline int findCommasSse2(const char *data, size_t length, size_t *offsets, int maxCommas)
+{
+    const __m128i comma = _mm_set1_epi8(',');
+    int found = 0;
+    size_t i = 0;
+    for (; i + 16 <= length && found < maxCommas; i += 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i *)(data + i));
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(block, comma));
+        while (mask && found < maxCommas)
+        {
+            offsets[found++] = i + __builtin_ctz(mask);
+            mask &= mask - 1;
+        }
+    }
+    if (found < maxCommas && i < length)
+    {
+        int tail = findCommasScalar(data + i, length - i, offsets + found, maxCommas - found);
+        for (int k = 0; k < tail; ++k)
+            offsets[found + k] += i;
+        found += tail;
+    }
+    return found;
+}
+
+// Same as the SSE2 path with 32-byte blocks; a typical row needs 4-5 loads.
+__attribute__((target("avx2"))) inline int findCommasAvx2(const char *data, size_t length, size_t *offsets, int maxCommas)
+{
+    const __m256i comma = _mm256_set1_epi8(',');
+    int found = 0;
+    size_t i = 0;
+    for (; i + 32 <= length && found < maxCommas; i += 32)
+    {
+        __m256i block = _mm256_loadu_si256((const __m256i *)(data + i));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, comma));
+        while (mask && found < maxCommas)
+        {
+            offsets[found++] = i + __builtin_ctz(mask);
+            mask &= mask - 1;
+        }
+    }
+    if (found < maxCommas && i < length)
+    {
+        int tail = findCommasSse2(data + i, length - i, offsets + found, maxCommas - found);
+        for (int k = 0; k < tail; ++k)
+            offsets[found + k] += i;
+        found += tail;
+    }
+    return found;
+}
+#endif
+
+// Picks the widest variant the running CPU supports, once.
+inline CommaFinder bestCommaFinder()
+{
+#ifdef CSV_SPLITTER_X86
+    static const CommaFinder finder = __builtin_cpu_supports("avx2")   ? findCommasAvx2
+                                      : __builtin_cpu_supports("sse2") ? findCommasSse2
+                                                                       : findCommasScalar;
+    return finder;
+#else
+    return findCommasScalar;
+#endif
+}
+
+inline const char *commaFinderName()
+{
+#ifdef CSV_SPLITTER_X86
+    CommaFinder finder = bestCommaFinder();
+    if (finder == findCommasAvx2)
+        return "AVX2";
+    if (finder == findCommasSse2)
+        return "SSE2";
+#endif
+    return "scalar";
+}
+
+// Locale-dependent conversion through a NUL-terminated copy, as stod does.
+inline double parseDoubleStrtod(string_view field)
+{
+    if (field.empty())
+        return 0.0;
+    char buffer[64];
+    size_t len = field.size() < sizeof(buffer) - 1 ? field.size() : sizeof(buffer) - 1;
+    field.copy(buffer, len);
+    buffer[len] = '\0';
+    return strtod(buffer, nullptr);
+}
+
+// Locale-free conversion straight from the mapped bytes. Inputs from_chars
+// does not take (a leading '+', surrounding blanks) go through strtod so
+// the result never differs from the old parser.
+inline double parseDoubleFast(string_view field)
+{
+    if (field.empty())
+        return 0.0;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    double value = 0.0;
+    auto result = from_chars(field.data(), field.data() + field.size(), value);
+    if (result.ec == errc() && result.ptr == field.data() + field.size())
+        return value;
+#endif
+    return parseDoubleStrtod(field);
+}
+
+#endif
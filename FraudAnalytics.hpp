@@ -0,0 +1,352 @@
+#ifndef FRAUDANALYTICS_HPP
+#define FRAUDANALYTICS_HPP
+
+#include <cstdint>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+#include "Transaction.hpp"
+#include "ArrayTransactionStore.hpp"
+#include "LinkedListTransactionStore.hpp"
+#include "ColumnarTransactionStore.hpp"
+using namespace std;
+
+// Fields the analytics can group rows by.
+enum GroupByField
+{
+    GROUP_BY_CHANNEL,
+    GROUP_BY_LOCATION,
+    GROUP_BY_MERCHANT_CATEGORY,
+    GROUP_BY_DEVICE_USED
+};
+
+inline const char *groupByFieldName(GroupByField field)
+{
+    switch (field)
+    {
+    case GROUP_BY_CHANNEL:
+        return "Payment Channel";
+    case GROUP_BY_LOCATION:
+        return "Location";
+    case GROUP_BY_MERCHANT_CATEGORY:
+        return "Merchant Category";
+    default:
+        return "Device Used";
+    }
+}
+
+// Name of group key under field: the channel stores are numbered, every
+// other field is a dictionary code.
+inline string groupLabel(GroupByField field, size_t key)
+{
+    static const char *channels[] = {"card", "ach", "upi", "wire_transfer"};
+    switch (field)
+    {
+    case GROUP_BY_CHANNEL:
+        return key < 4 ? channels[key] : "?";
+    case GROUP_BY_LOCATION:
+        return fieldDictionaries.location.decode((DictCode)key);
+    case GROUP_BY_MERCHANT_CATEGORY:
+        return fieldDictionaries.merchantCategory.decode((DictCode)key);
+    default:
+        return fieldDictionaries.deviceUsed.decode((DictCode)key);
+    }
+}
+
+#define SCORE_HISTOGRAM_BINS 10
+
+// geo_anomaly_score lies in [0, 1]: bins of 0.1. velocity_score counts
+// recent transactions: bins of 2, the last one open-ended. The score is
+// clamped while still a double, so NaN, infinities and huge values (which
+// from_chars accepts) never reach the int conversion.
+inline int scoreBin(double score, double binsPerUnit)
+{
+    double bin = score * binsPerUnit;
+    if (!(bin >= 0.0))
+        return 0;
+    if (bin >= SCORE_HISTOGRAM_BINS)
+        return SCORE_HISTOGRAM_BINS - 1;
+    return (int)bin;
+}
+
+inline int geoAnomalyBin(double score) { return scoreBin(score, SCORE_HISTOGRAM_BINS); }
+inline int velocityBin(double score) { return scoreBin(score, 0.5); }
+
+// Amount percentiles come from a log-linear histogram, which merges by
+// adding counts: 32 buckets per power of two (about 3% wide) from 2^-6 to
+// 2^34, read straight off the bits of the double. Amounts outside (NaN and
+// infinities included) land in the first or last bucket; the reported
+// percentile is clamped to the exact min and max.
+#define AMOUNT_SUB_BUCKET_BITS 5
+#define AMOUNT_MIN_EXPONENT (-6)
+#define AMOUNT_OCTAVES 40
+#define AMOUNT_SUB_BUCKETS (1 << AMOUNT_SUB_BUCKET_BITS)
+#define AMOUNT_BUCKETS (AMOUNT_OCTAVES << AMOUNT_SUB_BUCKET_BITS)
+
+inline int amountBucket(double amount)
+{
+    if (!(amount > 0.0))
+        return 0;
+    if (amount >= ldexp(1.0, AMOUNT_MIN_EXPONENT + AMOUNT_OCTAVES))
+        return AMOUNT_BUCKETS - 1;
+    uint64_t bits;
+    memcpy(&bits, &amount, sizeof(bits));
+    int exponent = (int)((bits >> 52) & 0x7FF) - 1023 - AMOUNT_MIN_EXPONENT;
+    if (exponent < 0)
+        return 0;
+    int subBucket = (int)((bits >> (52 - AMOUNT_SUB_BUCKET_BITS)) & (AMOUNT_SUB_BUCKETS - 1));
+    return (exponent << AMOUNT_SUB_BUCKET_BITS) | subBucket;
+}
+
+inline double amountBucketMidpoint(int bucket)
+{
+    int exponent = (bucket >> AMOUNT_SUB_BUCKET_BITS) + AMOUNT_MIN_EXPONENT;
+    double subBucket = (bucket & (AMOUNT_SUB_BUCKETS - 1)) + 0.5;
+    return ldexp(1.0 + subBucket / AMOUNT_SUB_BUCKETS, exponent);
+}
+
+// Row counts per amount bucket, allocated an octave at a time on first use:
+// a group pays for the range of amounts it saw (never more than the full
+// AMOUNT_BUCKETS), and merging skips octaves that were never hit.
+class AmountHistogram
+{
+private:
+    unsigned char octaveBlocks[AMOUNT_OCTAVES] = {}; // 1 + block in counts, 0 if untouched
+    vector<uint32_t> counts;
+
+    uint32_t *block(int octave)
+    {
+        if (octaveBlocks[octave] == 0)
+        {
+            counts.resize(counts.size() + AMOUNT_SUB_BUCKETS, 0);
+            octaveBlocks[octave] = (unsigned char)(counts.size() >> AMOUNT_SUB_BUCKET_BITS);
+        }
+        return &counts[(size_t)(octaveBlocks[octave] - 1) << AMOUNT_SUB_BUCKET_BITS];
+    }
+
+public:
+    void add(int bucket)
+    {
+        block(bucket >> AMOUNT_SUB_BUCKET_BITS)[bucket & (AMOUNT_SUB_BUCKETS - 1)]++;
+    }
+
+    void merge(const AmountHistogram &other)
+    {
+        for (int octave = 0; octave < AMOUNT_OCTAVES; ++octave)
+        {
+            if (other.octaveBlocks[octave] == 0)
+                continue;
+            uint32_t *mine = block(octave);
+            const uint32_t *theirs = &other.counts[(size_t)(other.octaveBlocks[octave] - 1) << AMOUNT_SUB_BUCKET_BITS];
+            for (int b = 0; b < AMOUNT_SUB_BUCKETS; ++b)
+                mine[b] += theirs[b];
+        }
+    }
+
+    // Calls visit(bucket, count) for every bucket of the touched octaves, in
+    // bucket order, until it returns false.
+    template <typename Visit>
+    void forEachBucket(Visit visit) const
+    {
+        for (int octave = 0; octave < AMOUNT_OCTAVES; ++octave)
+        {
+            if (octaveBlocks[octave] == 0)
+                continue;
+            const uint32_t *octaveCounts = &counts[(size_t)(octaveBlocks[octave] - 1) << AMOUNT_SUB_BUCKET_BITS];
+            for (int b = 0; b < AMOUNT_SUB_BUCKETS; ++b)
+            {
+                if (!visit((octave << AMOUNT_SUB_BUCKET_BITS) | b, octaveCounts[b]))
+                    return;
+            }
+        }
+    }
+};
+
+// Running totals of one group. Everything is a count, a sum or an extreme,
+// so two partial GroupStats of disjoint rows merge exactly.
+struct GroupStats
+{
+    long long rows = 0;
+    long long fraudRows = 0;
+    double amountSum = 0.0;
+    double fraudAmountSum = 0.0;
+    double amountMin = numeric_limits<double>::infinity();
+    double amountMax = -numeric_limits<double>::infinity();
+    double velocitySum = 0.0;
+    double geoAnomalySum = 0.0;
+    long long geoAnomalyHistogram[SCORE_HISTOGRAM_BINS] = {};
+    long long velocityHistogram[SCORE_HISTOGRAM_BINS] = {};
+    AmountHistogram amountHistogram;
+    vector<long long> fraudTypeRows;
+
+    void add(double amount, bool fraud, DictCode fraudType, double velocity, double geoAnomaly)
+    {
+        rows++;
+        amountSum += amount;
+        amountMin = amount < amountMin ? amount : amountMin;
+        amountMax = amount > amountMax ? amount : amountMax;
+        velocitySum += velocity;
+        geoAnomalySum += geoAnomaly;
+        amountHistogram.add(amountBucket(amount));
+        geoAnomalyHistogram[geoAnomalyBin(geoAnomaly)]++;
+        velocityHistogram[velocityBin(velocity)]++;
+        if (fraud)
+        {
+            fraudRows++;
+            fraudAmountSum += amount;
+            if (fraudType >= fraudTypeRows.size())
+                fraudTypeRows.resize(fraudType + 1, 0);
+            fraudTypeRows[fraudType]++;
+        }
+    }
+
+    void merge(const GroupStats &other)
+    {
+        if (other.rows == 0)
+            return;
+        if (rows == 0)
+        {
+            *this = other;
+            return;
+        }
+        rows += other.rows;
+        fraudRows += other.fraudRows;
+        amountSum += other.amountSum;
+        fraudAmountSum += other.fraudAmountSum;
+        amountMin = other.amountMin < amountMin ? other.amountMin : amountMin;
+        amountMax = other.amountMax > amountMax ? other.amountMax : amountMax;
+        velocitySum += other.velocitySum;
+        geoAnomalySum += other.geoAnomalySum;
+        for (int b = 0; b < SCORE_HISTOGRAM_BINS; ++b)
+        {
+            geoAnomalyHistogram[b] += other.geoAnomalyHistogram[b];
+            velocityHistogram[b] += other.velocityHistogram[b];
+        }
+        amountHistogram.merge(other.amountHistogram);
+        if (other.fraudTypeRows.size() > fraudTypeRows.size())
+            fraudTypeRows.resize(other.fraudTypeRows.size(), 0);
+        for (size_t code = 0; code < other.fraudTypeRows.size(); ++code)
+            fraudTypeRows[code] += other.fraudTypeRows[code];
+    }
+
+    double fraudRate() const { return rows > 0 ? (double)fraudRows / rows : 0.0; }
+    double amountAverage() const { return rows > 0 ? amountSum / rows : 0.0; }
+
+    // Nearest-rank percentile of amount, to the histogram's resolution.
+    double amountPercentile(double percent) const
+    {
+        if (rows == 0)
+            return 0.0;
+        long long rank = (long long)ceil(percent / 100.0 * rows);
+        rank = rank < 1 ? 1 : rank;
+        long long seen = 0;
+        double value = amountMax;
+        amountHistogram.forEachBucket([&](int bucket, uint32_t count)
+                                      {
+            seen += count;
+            if (seen < rank)
+                return true;
+            value = amountBucketMidpoint(bucket);
+            value = value < amountMin ? amountMin : value > amountMax ? amountMax : value;
+            return false; });
+        return value;
+    }
+
+    // Most frequent fraud_type among the fraud rows, or -1 without any.
+    int topFraudType() const
+    {
+        int best = -1;
+        for (size_t code = 0; code < fraudTypeRows.size(); ++code)
+        {
+            if (fraudTypeRows[code] > 0 && (best == -1 || fraudTypeRows[code] > fraudTypeRows[best]))
+                best = (int)code;
+        }
+        return best;
+    }
+};
+
+// Per-group totals indexed by group key. Each worker fills its own and the
+// partials are merged once at the end.
+class FraudAggregation
+{
+private:
+    vector<GroupStats> groups;
+
+public:
+    GroupStats &group(size_t key)
+    {
+        if (key >= groups.size())
+            groups.resize(key + 1);
+        return groups[key];
+    }
+
+    const vector<GroupStats> &getGroups() const { return groups; }
+
+    void merge(const FraudAggregation &other)
+    {
+        for (size_t key = 0; key < other.groups.size(); ++key)
+            group(key).merge(other.groups[key]);
+    }
+
+    GroupStats total() const
+    {
+        GroupStats all;
+        for (const GroupStats &stats : groups)
+            all.merge(stats);
+        return all;
+    }
+};
+
+inline size_t groupKey(GroupByField field, int channel, const Transaction &t)
+{
+    return field == GROUP_BY_CHANNEL            ? (size_t)channel
+           : field == GROUP_BY_LOCATION         ? t.location
+           : field == GROUP_BY_MERCHANT_CATEGORY ? t.merchant_category
+                                                 : t.device_used;
+}
+
+// One fused pass over rows [begin, end) of a channel's store: every metric
+// of every group is updated from a single read of the row.
+inline void aggregateRows(const ArrayTransactionStore &store, int channel, int begin, int end,
+                          GroupByField field, FraudAggregation &partial)
+{
+    for (int i = begin; i < end; ++i)
+    {
+        const Transaction &t = store.getRef(i);
+        partial.group(groupKey(field, channel, t)).add(t.amount, t.is_fraud, t.fraud_type, t.velocity_score, t.geo_anomaly_score);
+    }
+}
+
+// Only the columns involved are read.
+inline void aggregateRows(const ColumnarTransactionStore &store, int channel, int begin, int end,
+                          GroupByField field, FraudAggregation &partial)
+{
+    const double *amounts = store.getAmountColumn().data();
+    const unsigned char *fraudFlags = store.getFraudFlagColumn().data();
+    const DictCode *fraudTypes = store.getFraudTypeColumn().data();
+    const double *velocities = store.getVelocityScoreColumn().data();
+    const double *geoAnomalies = store.getGeoAnomalyScoreColumn().data();
+    const DictCode *keys = field == GROUP_BY_LOCATION           ? store.getLocationColumn().data()
+                           : field == GROUP_BY_MERCHANT_CATEGORY ? store.getMerchantCategoryColumn().data()
+                           : field == GROUP_BY_DEVICE_USED       ? store.getDeviceUsedColumn().data()
+                                                                 : nullptr;
+    GroupStats *channelGroup = keys ? nullptr : &partial.group(channel);
+    for (int i = begin; i < end; ++i)
+    {
+        GroupStats &stats = keys ? partial.group(keys[i]) : *channelGroup;
+        stats.add(amounts[i], fraudFlags[i] != 0, fraudTypes[i], velocities[i], geoAnomalies[i]);
+    }
+}
+
+// A list has no random access, so it is aggregated whole.
+inline void aggregateRows(const LinkedListTransactionStore &store, int channel, GroupByField field, FraudAggregation &partial)
+{
+    store.forEachInserted([&](const ListNode *node)
+                          {
+        const Transaction &t = node->data;
+        partial.group(groupKey(field, channel, t)).add(t.amount, t.is_fraud, t.fraud_type, t.velocity_score, t.geo_anomaly_score); });
+}
+
+#endif
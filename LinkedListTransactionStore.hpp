@@ -2,8 +2,15 @@
 #define LINKEDLISTTRANSACTIONSTORE_HPP
 #include <iostream>
 #include <iomanip>
+#include <new>
+#include <utility>
+#include <vector>
 using namespace std;
 #include "Transaction.hpp"
+#include "MemoryUsage.hpp"
+#include "TransactionTypeIndex.hpp"
+#include "SortKey.hpp"
+#include "NumericFilter.hpp"
 
 struct ListNode
 {
@@ -11,56 +18,317 @@ struct ListNode
     ListNode *next;
 };
 
+// Hands out ListNodes from cache-line aligned slabs in allocation order, so a
+// freshly loaded list is walked front to back through contiguous memory.
+// Nodes are never freed individually: reset() destroys them all and keeps
+// the slabs for reuse, release() returns the slabs to the heap. Because of
+// that, slab order is always the order the nodes were allocated in.
+class ListNodePool
+{
+private:
+    static const int NODES_PER_SLAB = 4096;
+    static const size_t SLAB_ALIGNMENT = 64;
+
+    vector<ListNode *> slabs;
+    size_t slabIndex; // slab currently being filled
+    int used;         // nodes constructed in slabs[slabIndex]
+    AllocationCounter allocations;
+
+    ListNode *nextSlot()
+    {
+        if (used == NODES_PER_SLAB)
+        {
+            slabIndex++;
+            used = 0;
+        }
+        if (slabIndex == slabs.size())
+        {
+            slabs.push_back(static_cast<ListNode *>(
+                ::operator new(sizeof(ListNode) * NODES_PER_SLAB, align_val_t(SLAB_ALIGNMENT))));
+            allocations.allocated(sizeof(ListNode) * NODES_PER_SLAB);
+        }
+        return &slabs[slabIndex][used];
+    }
+
+public:
+    ListNodePool() : slabIndex(0), used(0) {}
+    ~ListNodePool() { release(); }
+
+    ListNodePool(const ListNodePool &) = delete;
+    ListNodePool &operator=(const ListNodePool &) = delete;
+
+    template <typename T>
+    ListNode *allocate(T &&t)
+    {
+        ListNode *node = new (nextSlot()) ListNode{std::forward<T>(t), nullptr};
+        used++;
+        return node;
+    }
+
+    // Calls visit(node) for every live node in allocation order.
+    template <typename Visit>
+    void forEach(Visit visit) const
+    {
+        for (size_t s = 0; s < slabs.size() && s <= slabIndex; ++s)
+        {
+            int constructed = s < slabIndex ? NODES_PER_SLAB : used;
+            for (int i = 0; i < constructed; ++i)
+                visit(&slabs[s][i]);
+        }
+    }
+
+    void reset()
+    {
+        for (size_t s = 0; s < slabs.size() && s <= slabIndex; ++s)
+        {
+            int constructed = s < slabIndex ? NODES_PER_SLAB : used;
+            for (int i = 0; i < constructed; ++i)
+                slabs[s][i].~ListNode();
+        }
+        slabIndex = 0;
+        used = 0;
+    }
+
+    void release()
+    {
+        reset();
+        for (ListNode *slab : slabs)
+        {
+            ::operator delete(slab, align_val_t(SLAB_ALIGNMENT));
+            allocations.released(sizeof(ListNode) * NODES_PER_SLAB);
+        }
+        slabs.clear();
+    }
+
+    size_t reservedBytes() const { return slabs.size() * NODES_PER_SLAB * sizeof(ListNode); }
+
+    // Counted slab allocations, live and at peak.
+    const AllocationCounter &getAllocations() const { return allocations; }
+    void resetAllocationPeak() { allocations.resetPeak(); }
+};
+
 class LinkedListTransactionStore
 {
 private:
     ListNode *head;
     ListNode *tail;
     int count;
+    ListNodePool pool;
+    mutable TransactionTypeIndex<NodePosting> typeIndex;
+    mutable bool typeIndexStale;
+    // Numeric columns in insertion order, and the node of each of their rows.
+    mutable PackedNumericColumns numericColumns;
+    mutable vector<ListNode *> numericRowNodes;
+    mutable bool numericColumnsStale;
+    // checkpoints[c] is the node at position c * skipInterval; empty when
+    // the skip index is disabled (skipInterval == 0).
+    vector<ListNode *> checkpoints;
+    int skipInterval;
+    // Key order of the current chain; empty while it is in insertion order.
+    vector<SortField> sortFields;
 
-public:
-    LinkedListTransactionStore() : head(nullptr), tail(nullptr), count(0) {}
-    ~LinkedListTransactionStore() { clear(); }
-
-    void add(const Transaction &t)
+    void append(ListNode *node)
     {
-        ListNode *node = new ListNode{t, nullptr};
         if (!head)
             head = tail = node;
         else
             tail->next = node, tail = node;
+        if (skipInterval > 0 && count % skipInterval == 0)
+            checkpoints.push_back(node);
         count++;
+        typeIndexStale = true;
+        numericColumnsStale = true;
+        sortFields.clear();
     }
 
+public:
+    static const int DEFAULT_SKIP_INTERVAL = 64;
+
+    explicit LinkedListTransactionStore(int interval = DEFAULT_SKIP_INTERVAL)
+        : head(nullptr), tail(nullptr), count(0), typeIndexStale(true), numericColumnsStale(true),
+          skipInterval(interval > 0 ? interval : 0) {}
+
+    LinkedListTransactionStore(const LinkedListTransactionStore &) = delete;
+    LinkedListTransactionStore &operator=(const LinkedListTransactionStore &) = delete;
+
+    void add(const Transaction &t) { append(pool.allocate(t)); }
+    void add(Transaction &&t) { append(pool.allocate(std::move(t))); }
+
     int size() const { return count; }
 
     ListNode *getHead() const { return head; }
 
-    void setHead(ListNode *newHead)
+    // Node at position index, or nullptr when out of range. With the skip
+    // index this is at most skipInterval - 1 hops from the nearest
+    // checkpoint; without it, a walk from the head.
+    ListNode *nodeAt(int index) const
+    {
+        if (index < 0 || index >= count)
+            return nullptr;
+        ListNode *curr = head;
+        int hops = index;
+        if (skipInterval > 0)
+        {
+            curr = checkpoints[index / skipInterval];
+            hops = index % skipInterval;
+        }
+        while (hops-- > 0)
+            curr = curr->next;
+        return curr;
+    }
+
+    // Changes the checkpoint spacing; 0 disables the skip index.
+    void setSkipInterval(int interval)
+    {
+        skipInterval = interval > 0 ? interval : 0;
+        rebuildSkipIndex();
+    }
+
+    int getSkipInterval() const { return skipInterval; }
+
+    void rebuildSkipIndex()
+    {
+        checkpoints.clear();
+        if (skipInterval == 0)
+            return;
+        checkpoints.reserve(count / skipInterval + 1);
+        int position = 0;
+        for (ListNode *curr = head; curr; curr = curr->next, ++position)
+        {
+            if (position % skipInterval == 0)
+                checkpoints.push_back(curr);
+        }
+    }
+
+    size_t reservedBytes() const { return pool.reservedBytes(); }
+    const AllocationCounter &getAllocations() const { return pool.getAllocations(); }
+    void resetAllocationPeak() { pool.resetAllocationPeak(); }
+
+    // Heap bytes owned by the store: the node slabs, the strings' heap data,
+    // the skip index and the type index.
+    size_t footprintBytes() const
+    {
+        size_t total = (size_t)pool.getAllocations().liveBytes() + checkpoints.capacity() * sizeof(ListNode *) + typeIndex.bytes() +
+                       numericColumns.bytes() + numericRowNodes.capacity() * sizeof(ListNode *);
+        pool.forEach([&](const ListNode *node)
+                     { total += stringHeapBytes(node->data); });
+        return total;
+    }
+
+    // newHead must be a relinking of nodes already owned by this store;
+    // fields records the key order it is in, if any.
+    void setHead(ListNode *newHead, const vector<SortField> &fields = {})
     {
         head = newHead;
         tail = nullptr;
         count = 0;
+        checkpoints.clear();
         ListNode *curr = head;
         while (curr)
         {
+            if (skipInterval > 0 && count % skipInterval == 0)
+                checkpoints.push_back(curr);
             count++;
             if (!curr->next)
                 tail = curr;
             curr = curr->next;
         }
+        sortFields = fields;
     }
 
-    void clear()
+    // Visits every node in insertion order, whatever order the chain is in.
+    // Sorting only relinks nodes, so this replaces a separate unsorted copy.
+    template <typename Visit>
+    void forEachInserted(Visit visit) const { pool.forEach(visit); }
+
+    // Relinks the chain back into insertion order.
+    void restoreInsertionOrder()
+    {
+        ListNode *first = nullptr, *last = nullptr;
+        pool.forEach([&](ListNode *node)
+                     {
+            node->next = nullptr;
+            if (!first)
+                first = node;
+            else
+                last->next = node;
+            last = node; });
+        setHead(first);
+    }
+
+    // Nodes and their insertion positions per transaction_type code; rebuilt
+    // on first use after the list is extended. Relinking does not affect it.
+    const TransactionTypeIndex<NodePosting> &getTypeIndex() const
+    {
+        if (typeIndexStale)
+            rebuildTypeIndex();
+        return typeIndex;
+    }
+
+    void rebuildTypeIndex() const
+    {
+        typeIndex.clear();
+        int position = 0;
+        pool.forEach([&](ListNode *node)
+                     { typeIndex.add(node->data.transaction_type, NodePosting{position++, node}); });
+        typeIndexStale = false;
+    }
+
+    // amount, velocity_score, geo_anomaly_score and is_fraud packed into
+    // columns in insertion order for the vectorized filters, built on first
+    // use after the list is extended; numericRowNode maps a row back to its
+    // node. Relinking does not affect either.
+    NumericColumnView getNumericColumns() const
     {
-        while (head)
+        if (numericColumnsStale)
         {
-            ListNode *temp = head;
-            head = head->next;
-            delete temp;
+            numericColumns.clear();
+            numericColumns.reserve(count);
+            numericRowNodes.clear();
+            numericRowNodes.reserve(count);
+            pool.forEach([&](ListNode *node)
+                         {
+                numericColumns.add(node->data);
+                numericRowNodes.push_back(node); });
+            numericColumnsStale = false;
         }
+        return numericColumns.view();
+    }
+
+    ListNode *numericRowNode(int row) const { return numericRowNodes[row]; }
+
+    const vector<SortField> &getSortFields() const { return sortFields; }
+
+    // Chain positions [first, last) whose key equals code, found by binary
+    // search. Returns false, with an empty range, unless the chain is sorted
+    // on key first. Probes go through nodeAt, so each costs at most one skip
+    // interval of hops.
+    bool equalRange(SortKey key, int code, int &first, int &last) const
+    {
+        first = last = 0;
+        if (sortFields.empty() || sortFields[0].key != key)
+            return false;
+        if (code < 0)
+            return true;
+        const vector<int> &ranks = sortKeyRanks(key);
+        equalRankRange(count, ranks[code], sortFields[0].ascending, [&](int i)
+                       { return ranks[sortKeyCode(nodeAt(i)->data, key)]; }, first, last);
+        return true;
+    }
+
+    // Destroys every node in one pass over the slabs; the memory is kept.
+    void clear()
+    {
+        pool.reset();
         head = tail = nullptr;
         count = 0;
+        checkpoints.clear();
+        typeIndex.clear();
+        typeIndexStale = true;
+        numericColumns.clear();
+        vector<ListNode *>().swap(numericRowNodes);
+        numericColumnsStale = true;
+        sortFields.clear();
     }
 
     void printAll(int max = 5) const
@@ -71,11 +339,11 @@ public:
         {
             cout << fixed << setprecision(2);
             cout << "ID: " << curr->data.transaction_id
-                 << " | Location: " << curr->data.location
+                 << " | Location: " << fieldDictionaries.location.decode(curr->data.location)
                  << " | Amount: " << curr->data.amount
-                 << " | Type: " << curr->data.transaction_type
+                 << " | Type: " << fieldDictionaries.transactionType.decode(curr->data.transaction_type)
                  << " | Fraud: " << (curr->data.is_fraud ? "YES" : "NO")
-                 << " | Channel: " << curr->data.payment_channel << endl;
+                 << " | Channel: " << fieldDictionaries.paymentChannel.decode(curr->data.payment_channel) << endl;
             curr = curr->next;
             shown++;
         }
@@ -0,0 +1,121 @@
+#ifndef MEMORYUSAGE_HPP
+#define MEMORYUSAGE_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__linux__)
+#include <fstream>
+#endif
+using namespace std;
+
+// Resident set size of the process now and at its peak, in MB. Zero where
+// the platform offers no cheap way to read them.
+struct ProcessMemory
+{
+    double rssMB = 0.0;
+    double peakRssMB = 0.0;
+};
+
+inline ProcessMemory readProcessMemory()
+{
+    ProcessMemory memory;
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+    {
+        memory.rssMB = pmc.WorkingSetSize / (1024.0 * 1024.0);
+        memory.peakRssMB = pmc.PeakWorkingSetSize / (1024.0 * 1024.0);
+    }
+#elif defined(__linux__)
+    // VmRSS and VmHWM (the high-water mark) are reported in kB.
+    ifstream status("/proc/self/status");
+    string line;
+    while (getline(status, line))
+    {
+        if (line.compare(0, 6, "VmRSS:") == 0)
+            memory.rssMB = strtod(line.c_str() + 6, nullptr) / 1024.0;
+        else if (line.compare(0, 6, "VmHWM:") == 0)
+            memory.peakRssMB = strtod(line.c_str() + 6, nullptr) / 1024.0;
+    }
+#endif
+    return memory;
+}
+
+// Live and peak bytes of the allocations one store makes for its own
+// storage. The store feeds it from its allocation paths (row buffer, node
+// slabs, column vectors), so the bytes are attributed per store and nothing
+// else in the process pays for the counting. Updated by the store's single
+// writer, like the rest of the store.
+class AllocationCounter
+{
+private:
+    long long live = 0;
+    long long peak = 0;
+
+public:
+    void allocated(size_t bytes)
+    {
+        live += (long long)bytes;
+        peak = live > peak ? live : peak;
+    }
+    void released(size_t bytes) { live -= (long long)bytes; }
+
+    long long liveBytes() const { return live; }
+    long long peakBytes() const { return peak; }
+
+    // Starts a new measurement window: the peak drops to what is live now.
+    void resetPeak() { peak = live; }
+};
+
+// Standard allocator that reports to an AllocationCounter; containers using
+// it count their buffers against the store that owns them.
+template <typename T>
+struct CountingAllocator
+{
+    typedef T value_type;
+    typedef true_type propagate_on_container_move_assignment;
+    typedef true_type propagate_on_container_swap;
+
+    AllocationCounter *counter;
+
+    explicit CountingAllocator(AllocationCounter *counter = nullptr) noexcept : counter(counter) {}
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U> &other) noexcept : counter(other.counter) {}
+
+    T *allocate(size_t n)
+    {
+        T *block = allocator<T>().allocate(n);
+        if (counter)
+            counter->allocated(n * sizeof(T));
+        return block;
+    }
+
+    void deallocate(T *block, size_t n) noexcept
+    {
+        if (counter)
+            counter->released(n * sizeof(T));
+        allocator<T>().deallocate(block, n);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U> &other) const { return counter == other.counter; }
+    template <typename U>
+    bool operator!=(const CountingAllocator<U> &other) const { return counter != other.counter; }
+};
+
+template <typename T>
+using CountedVector = vector<T, CountingAllocator<T>>;
+
+#endif
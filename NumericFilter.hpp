@@ -0,0 +1,615 @@
+#ifndef NUMERICFILTER_HPP
+#define NUMERICFILTER_HPP
+
+#include <algorithm>
+#include <bitset>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "Transaction.hpp"
+using namespace std;
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define NUMERIC_FILTER_X86 1
+#endif
+
+// The numeric fields of a store laid out as packed columns in insertion
+// order, one value per row. The columnar store points into its own columns;
+// the others fill a PackedNumericColumns on demand.
+struct NumericColumnView
+{
+    const double *amount = nullptr;
+    const double *velocityScore = nullptr;
+    const double *geoAnomalyScore = nullptr;
+    const unsigned char *fraudFlag = nullptr;
+    int rows = 0;
+};
+
+class PackedNumericColumns
+{
+private:
+    vector<double> amounts;
+    vector<double> velocityScores;
+    vector<double> geoAnomalyScores;
+    vector<unsigned char> fraudFlags;
+
+public:
+    void reserve(int rows)
+    {
+        amounts.reserve(rows);
+        velocityScores.reserve(rows);
+        geoAnomalyScores.reserve(rows);
+        fraudFlags.reserve(rows);
+    }
+
+    void add(const Transaction &t)
+    {
+        amounts.push_back(t.amount);
+        velocityScores.push_back(t.velocity_score);
+        geoAnomalyScores.push_back(t.geo_anomaly_score);
+        fraudFlags.push_back(t.is_fraud ? 1 : 0);
+    }
+
+    void clear()
+    {
+        vector<double>().swap(amounts);
+        vector<double>().swap(velocityScores);
+        vector<double>().swap(geoAnomalyScores);
+        vector<unsigned char>().swap(fraudFlags);
+    }
+
+    NumericColumnView view() const
+    {
+        return NumericColumnView{amounts.data(), velocityScores.data(), geoAnomalyScores.data(),
+                                 fraudFlags.data(), (int)amounts.size()};
+    }
+
+    size_t bytes() const
+    {
+        return (amounts.capacity() + velocityScores.capacity() + geoAnomalyScores.capacity()) * sizeof(double) +
+               fraudFlags.capacity();
+    }
+};
+
+// One bit per row, 64 rows per word; bits past the row count stay clear.
+class SelectionBitmap
+{
+private:
+    vector<uint64_t> words;
+    int rows = 0;
+
+    static int lowestSetBit(uint64_t word)
+    {
+#ifdef __GNUC__
+        return __builtin_ctzll(word);
+#else
+        int bit = 0;
+        while (!(word & 1))
+        {
+            word >>= 1;
+            bit++;
+        }
+        return bit;
+#endif
+    }
+
+public:
+    // Selects every one of rowCount rows.
+    void selectAll(int rowCount)
+    {
+        rows = rowCount;
+        words.assign((rowCount + 63) / 64, ~0ULL);
+        if (rowCount % 64 != 0)
+            words.back() = (1ULL << (rowCount % 64)) - 1;
+    }
+
+    void clear() { fill(words.begin(), words.end(), 0ULL); }
+
+    uint64_t *data() { return words.data(); }
+    int size() const { return rows; }
+
+    int count() const
+    {
+        int total = 0;
+        for (uint64_t word : words)
+            total += (int)bitset<64>(word).count();
+        return total;
+    }
+
+    // Calls visit(row) for every selected row in ascending order.
+    template <typename Visit>
+    void forEachSelected(Visit visit) const
+    {
+        for (size_t w = 0; w < words.size(); ++w)
+        {
+            uint64_t word = words[w];
+            while (word)
+            {
+                visit((int)(w * 64) + lowestSetBit(word));
+                word &= word - 1;
+            }
+        }
+    }
+};
+
+enum NumericField
+{
+    NUMERIC_FIELD_AMOUNT,
+    NUMERIC_FIELD_VELOCITY_SCORE,
+    NUMERIC_FIELD_GEO_ANOMALY_SCORE,
+    NUMERIC_FIELD_IS_FRAUD
+};
+
+enum CompareOp
+{
+    COMPARE_LT,
+    COMPARE_LE,
+    COMPARE_GT,
+    COMPARE_GE,
+    COMPARE_EQ,
+    COMPARE_NE
+};
+
+// field op value. is_fraud compares as 0 or 1.
+struct NumericPredicate
+{
+    NumericField field;
+    CompareOp op;
+    double value;
+};
+
+inline const char *numericFieldName(NumericField field)
+{
+    switch (field)
+    {
+    case NUMERIC_FIELD_AMOUNT:
+        return "amount";
+    case NUMERIC_FIELD_VELOCITY_SCORE:
+        return "velocity_score";
+    case NUMERIC_FIELD_GEO_ANOMALY_SCORE:
+        return "geo_anomaly_score";
+    default:
+        return "is_fraud";
+    }
+}
+
+inline const char *compareOpSymbol(CompareOp op)
+{
+    const char *symbols[] = {"<", "<=", ">", ">=", "=", "!="};
+    return symbols[op];
+}
+
+// As the vector paths compare: false whenever either side is NaN, != too.
+template <CompareOp Op>
+inline bool compareValue(double value, double threshold)
+{
+    if constexpr (Op == COMPARE_LT)
+        return value < threshold;
+    else if constexpr (Op == COMPARE_LE)
+        return value <= threshold;
+    else if constexpr (Op == COMPARE_GT)
+        return value > threshold;
+    else if constexpr (Op == COMPARE_GE)
+        return value >= threshold;
+    else if constexpr (Op == COMPARE_EQ)
+        return value == threshold;
+    else
+        return value < threshold || value > threshold;
+}
+
+inline bool compareValue(double value, CompareOp op, double threshold)
+{
+    switch (op)
+    {
+    case COMPARE_LT:
+        return compareValue<COMPARE_LT>(value, threshold);
+    case COMPARE_LE:
+        return compareValue<COMPARE_LE>(value, threshold);
+    case COMPARE_GT:
+        return compareValue<COMPARE_GT>(value, threshold);
+    case COMPARE_GE:
+        return compareValue<COMPARE_GE>(value, threshold);
+    case COMPARE_EQ:
+        return compareValue<COMPARE_EQ>(value, threshold);
+    default:
+        return compareValue<COMPARE_NE>(value, threshold);
+    }
+}
+
+// Filters AND the outcome of one comparison into the selection: word w
+// covers values [64w, 64w + 64). All variants produce identical bitmaps.
+typedef void (*DoubleFilter)(const double *values, int count, CompareOp op, double threshold, uint64_t *words);
+typedef void (*FlagFilter)(const unsigned char *flags, int count, unsigned char wanted, uint64_t *words);
+
+template <CompareOp Op>
+inline void filterDoublesScalarFor(const double *values, int count, double threshold, uint64_t *words)
+{
+    for (int base = 0; base < count; base += 64)
+    {
+        int n = count - base < 64 ? count - base : 64;
+        uint64_t mask = 0;
+        for (int i = 0; i < n; ++i)
+            mask |= (uint64_t)compareValue<Op>(values[base + i], threshold) << i;
+        words[base / 64] &= mask;
+    }
+}
+
+inline void filterDoublesScalar(const double *values, int count, CompareOp op, double threshold, uint64_t *words)
+{
+    switch (op)
+    {
+    case COMPARE_LT:
+        return filterDoublesScalarFor<COMPARE_LT>(values, count, threshold, words);
+    case COMPARE_LE:
+        return filterDoublesScalarFor<COMPARE_LE>(values, count, threshold, words);
+    case COMPARE_GT:
+        return filterDoublesScalarFor<COMPARE_GT>(values, count, threshold, words);
+    case COMPARE_GE:
+        return filterDoublesScalarFor<COMPARE_GE>(values, count, threshold, words);
+    case COMPARE_EQ:
+        return filterDoublesScalarFor<COMPARE_EQ>(values, count, threshold, words);
+    default:
+        return filterDoublesScalarFor<COMPARE_NE>(values, count, threshold, words);
+    }
+}
+
+inline void filterFlagsScalar(const unsigned char *flags, int count, unsigned char wanted, uint64_t *words)
+{
+    for (int base = 0; base < count; base += 64)
+    {
+        int n = count - base < 64 ? count - base : 64;
+        uint64_t mask = 0;
+        for (int i = 0; i < n; ++i)
+            mask |= (uint64_t)(flags[base + i] == wanted) << i;
+        words[base / 64] &= mask;
+    }
+}
+
+#ifdef NUMERIC_FILTER_X86
+// Two doubles per compare, 32 compares per word; the partial last word
+// goes through the scalar loop.
+template <CompareOp Op>
+__attribute__((target("sse2"))) inline void filterDoublesSse2For(const double *values, int count, double threshold, uint64_t *words)
+{
+    const __m128d limit = _mm_set1_pd(threshold);
+    int full = count / 64 * 64;
+    for (int base = 0; base < full; base += 64)
+    {
+        uint64_t mask = 0;
+        for (int k = 0; k < 64; k += 2)
+        {
+            __m128d block = _mm_loadu_pd(values + base + k);
+            __m128d hit;
+            if constexpr (Op == COMPARE_LT)
+                hit = _mm_cmplt_pd(block, limit);
+            else if constexpr (Op == COMPARE_LE)
+                hit = _mm_cmple_pd(block, limit);
+            else if constexpr (Op == COMPARE_GT)
+                hit = _mm_cmpgt_pd(block, limit);
+            else if constexpr (Op == COMPARE_GE)
+                hit = _mm_cmpge_pd(block, limit);
+            else if constexpr (Op == COMPARE_EQ)
+                hit = _mm_cmpeq_pd(block, limit);
+            else // cmpneq is unordered, so NaN would pass
+                hit = _mm_or_pd(_mm_cmplt_pd(block, limit), _mm_cmpgt_pd(block, limit));
+            mask |= (uint64_t)_mm_movemask_pd(hit) << k;
+        }
+        words[base / 64] &= mask;
+    }
+    if (full < count)
+        filterDoublesScalarFor<Op>(values + full, count - full, threshold, words + full / 64);
+}
+
+__attribute__((target("sse2"))) inline void filterDoublesSse2(const double *values, int count, CompareOp op, double threshold, uint64_t *words)
+{
+    switch (op)
+    {
+    case COMPARE_LT:
+        return filterDoublesSse2For<COMPARE_LT>(values, count, threshold, words);
+    case COMPARE_LE:
+        return filterDoublesSse2For<COMPARE_LE>(values, count, threshold, words);
+    case COMPARE_GT:
+        return filterDoublesSse2For<COMPARE_GT>(values, count, threshold, words);
+    case COMPARE_GE:
+        return filterDoublesSse2For<COMPARE_GE>(values, count, threshold, words);
+    case COMPARE_EQ:
+        return filterDoublesSse2For<COMPARE_EQ>(values, count, threshold, words);
+    default:
+        return filterDoublesSse2For<COMPARE_NE>(values, count, threshold, words);
+    }
+}
+
+// Four doubles per compare; the predicates are the ordered, non-signalling
+// ones, so NaN never matches, as in the scalar loop.
+template <int Predicate, CompareOp Op>
+__attribute__((target("avx2"))) inline void filterDoublesAvx2For(const double *values, int count, double threshold, uint64_t *words)
+{
+    const __m256d limit = _mm256_set1_pd(threshold);
+    int full = count / 64 * 64;
+    for (int base = 0; base < full; base += 64)
+    {
+        uint64_t mask = 0;
+        for (int k = 0; k < 64; k += 4)
+        {
+            __m256d block = _mm256_loadu_pd(values + base + k);
+            mask |= (uint64_t)_mm256_movemask_pd(_mm256_cmp_pd(block, limit, Predicate)) << k;
+        }
+        words[base / 64] &= mask;
+    }
+    if (full < count)
+        filterDoublesScalarFor<Op>(values + full, count - full, threshold, words + full / 64);
+}
+
+__attribute__((target("avx2"))) inline void filterDoublesAvx2(const double *values, int count, CompareOp op, double threshold, uint64_t *words)
+{
+    switch (op)
+    {
+    case COMPARE_LT:
+        return filterDoublesAvx2For<_CMP_LT_OQ, COMPARE_LT>(values, count, threshold, words);
+    case COMPARE_LE:
+        return filterDoublesAvx2For<_CMP_LE_OQ, COMPARE_LE>(values, count, threshold, words);
+    case COMPARE_GT:
+        return filterDoublesAvx2For<_CMP_GT_OQ, COMPARE_GT>(values, count, threshold, words);
+    case COMPARE_GE:
+        return filterDoublesAvx2For<_CMP_GE_OQ, COMPARE_GE>(values, count, threshold, words);
+    case COMPARE_EQ:
+        return filterDoublesAvx2For<_CMP_EQ_OQ, COMPARE_EQ>(values, count, threshold, words);
+    default:
+        return filterDoublesAvx2For<_CMP_NEQ_OQ, COMPARE_NE>(values, count, threshold, words);
+    }
+}
+
+// Sixteen flags per compare, four per word.
+__attribute__((target("sse2"))) inline void filterFlagsSse2(const unsigned char *flags, int count, unsigned char wanted, uint64_t *words)
+{
+    const __m128i target = _mm_set1_epi8((char)wanted);
+    int full = count / 64 * 64;
+    for (int base = 0; base < full; base += 64)
+    {
+        uint64_t mask = 0;
+        for (int k = 0; k < 64; k += 16)
+        {
+            __m128i block = _mm_loadu_si128((const __m128i *)(flags + base + k));
+            mask |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(block, target)) << k;
+        }
+        words[base / 64] &= mask;
+    }
+    if (full < count)
+        filterFlagsScalar(flags + full, count - full, wanted, words + full / 64);
+}
+
+__attribute__((target("avx2"))) inline void filterFlagsAvx2(const unsigned char *flags, int count, unsigned char wanted, uint64_t *words)
+{
+    const __m256i target = _mm256_set1_epi8((char)wanted);
+    int full = count / 64 * 64;
+    for (int base = 0; base < full; base += 64)
+    {
+        __m256i low = _mm256_loadu_si256((const __m256i *)(flags + base));
+        __m256i high = _mm256_loadu_si256((const __m256i *)(flags + base + 32));
+        uint64_t lowMask = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, target));
+        uint64_t highMask = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, target));
+        words[base / 64] &= lowMask | highMask << 32;
+    }
+    if (full < count)
+        filterFlagsScalar(flags + full, count - full, wanted, words + full / 64);
+}
+#endif
+
+// Picks the widest variants the running CPU supports, once.
+inline DoubleFilter bestDoubleFilter()
+{
+#ifdef NUMERIC_FILTER_X86
+    static const DoubleFilter filter = __builtin_cpu_supports("avx2")   ? filterDoublesAvx2
+                                       : __builtin_cpu_supports("sse2") ? filterDoublesSse2
+                                                                        : filterDoublesScalar;
+    return filter;
+#else
+    return filterDoublesScalar;
+#endif
+}
+
+inline FlagFilter bestFlagFilter()
+{
+#ifdef NUMERIC_FILTER_X86
+    static const FlagFilter filter = __builtin_cpu_supports("avx2")   ? filterFlagsAvx2
+                                     : __builtin_cpu_supports("sse2") ? filterFlagsSse2
+                                                                      : filterFlagsScalar;
+    return filter;
+#else
+    return filterFlagsScalar;
+#endif
+}
+
+inline const char *numericFilterName()
+{
+#ifdef NUMERIC_FILTER_X86
+    DoubleFilter filter = bestDoubleFilter();
+    if (filter == filterDoublesAvx2)
+        return "AVX2";
+    if (filter == filterDoublesSse2)
+        return "SSE2";
+#endif
+    return "scalar";
+}
+
+// Selects the rows of columns that satisfy every predicate.
+inline void filterRows(const NumericColumnView &columns, const vector<NumericPredicate> &predicates,
+                       SelectionBitmap &selection, DoubleFilter doubleFilter = bestDoubleFilter(),
+                       FlagFilter flagFilter = bestFlagFilter())
+{
+    selection.selectAll(columns.rows);
+    for (const NumericPredicate &predicate : predicates)
+    {
+        if (predicate.field == NUMERIC_FIELD_IS_FRAUD)
+        {
+            // The flag only takes 0 and 1: keep the rows of whichever value
+            // passes, all of them, or none.
+            bool passFalse = compareValue(0.0, predicate.op, predicate.value);
+            bool passTrue = compareValue(1.0, predicate.op, predicate.value);
+            if (passFalse != passTrue)
+                flagFilter(columns.fraudFlag, columns.rows, passTrue ? 1 : 0, selection.data());
+            else if (!passTrue)
+                selection.clear();
+            continue;
+        }
+        const double *values = predicate.field == NUMERIC_FIELD_AMOUNT           ? columns.amount
+                               : predicate.field == NUMERIC_FIELD_VELOCITY_SCORE ? columns.velocityScore
+                                                                                 : columns.geoAnomalyScore;
+        doubleFilter(values, columns.rows, predicate.op, predicate.value, selection.data());
+    }
+}
+
+// Parses conditions joined by "and", e.g.
+//   amount > 1000 and geo_anomaly_score >= 0.8 and is_fraud
+// with <, <=, >, >=, = (or ==) and !=. A bare is_fraud means is_fraud = 1,
+// "not is_fraud" is_fraud = 0. Returns false with a message in error on
+// anything else.
+inline bool parseNumericPredicates(const string &text, vector<NumericPredicate> &predicates, string &error)
+{
+    predicates.clear();
+    vector<string> tokens;
+    for (size_t i = 0; i < text.size();)
+    {
+        char c = text[i];
+        if (isspace((unsigned char)c))
+        {
+            ++i;
+            continue;
+        }
+        size_t begin = i;
+        if (c == '<' || c == '>' || c == '=' || c == '!')
+        {
+            ++i;
+            if (i < text.size() && text[i] == '=')
+                ++i;
+        }
+        else
+        {
+            while (i < text.size() && !isspace((unsigned char)text[i]) && text[i] != '<' && text[i] != '>' &&
+                   text[i] != '=' && text[i] != '!')
+                ++i;
+        }
+        string token = text.substr(begin, i - begin);
+        for (char &ch : token)
+            ch = (char)tolower((unsigned char)ch);
+        tokens.push_back(token);
+    }
+
+    size_t t = 0;
+    while (t < tokens.size())
+    {
+        bool negated = false;
+        if (tokens[t] == "not" || tokens[t] == "!")
+        {
+            negated = true;
+            ++t;
+        }
+        if (t >= tokens.size())
+        {
+            error = "Expected a field after \"not\".";
+            return false;
+        }
+
+        string name = tokens[t++];
+        NumericField field;
+        if (name == "amount")
+            field = NUMERIC_FIELD_AMOUNT;
+        else if (name == "velocity_score" || name == "velocity")
+            field = NUMERIC_FIELD_VELOCITY_SCORE;
+        else if (name == "geo_anomaly_score" || name == "geo")
+            field = NUMERIC_FIELD_GEO_ANOMALY_SCORE;
+        else if (name == "is_fraud" || name == "fraud")
+            field = NUMERIC_FIELD_IS_FRAUD;
+        else
+        {
+            error = "Unknown field \"" + name + "\".";
+            return false;
+        }
+
+        NumericPredicate predicate{field, COMPARE_EQ, negated ? 0.0 : 1.0};
+        bool hasComparison = t < tokens.size() && tokens[t] != "and";
+        if (hasComparison)
+        {
+            string op = tokens[t++];
+            if (op == "<")
+                predicate.op = COMPARE_LT;
+            else if (op == "<=")
+                predicate.op = COMPARE_LE;
+            else if (op == ">")
+                predicate.op = COMPARE_GT;
+            else if (op == ">=")
+                predicate.op = COMPARE_GE;
+            else if (op == "=" || op == "==")
+                predicate.op = COMPARE_EQ;
+            else if (op == "!=")
+                predicate.op = COMPARE_NE;
+            else
+            {
+                error = "Unknown comparison \"" + op + "\".";
+                return false;
+            }
+            if (t >= tokens.size())
+            {
+                error = "Missing value after " + name + " " + op + ".";
+                return false;
+            }
+            string value = tokens[t++];
+            char *end = nullptr;
+            predicate.value = strtod(value.c_str(), &end);
+            if (value == "true" || value == "false")
+                predicate.value = value == "true" ? 1.0 : 0.0;
+            else if (end == value.c_str() || *end != '\0')
+            {
+                error = "\"" + value + "\" is not a number.";
+                return false;
+            }
+            if (negated)
+            {
+                error = "\"not\" only applies to is_fraud on its own.";
+                return false;
+            }
+        }
+        else if (field != NUMERIC_FIELD_IS_FRAUD)
+        {
+            error = string("Missing comparison after ") + numericFieldName(field) + ".";
+            return false;
+        }
+        predicates.push_back(predicate);
+
+        if (t < tokens.size())
+        {
+            if (tokens[t] != "and" || t + 1 >= tokens.size())
+            {
+                error = "Expected \"and\" between conditions.";
+                return false;
+            }
+            ++t;
+        }
+    }
+    if (predicates.empty())
+    {
+        error = "No conditions given.";
+        return false;
+    }
+    return true;
+}
+
+inline string describePredicates(const vector<NumericPredicate> &predicates)
+{
+    string text;
+    for (const NumericPredicate &predicate : predicates)
+    {
+        if (!text.empty())
+            text += " and ";
+        char value[32];
+        snprintf(value, sizeof(value), "%g", predicate.value);
+        text += string(numericFieldName(predicate.field)) + " " + compareOpSymbol(predicate.op) + " " + value;
+    }
+    return text;
+}
+
+#endif
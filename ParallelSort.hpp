@@ -0,0 +1,467 @@
+#ifndef PARALLELSORT_HPP
+#define PARALLELSORT_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "SortIndex.hpp"
+using namespace std;
+
+// Fixed set of workers, each with its own task deque. A worker pushes and
+// pops at the back of its own deque (newest first, cache-warm) and, when it
+// runs dry, steals from the front of the others (oldest, usually largest).
+class WorkStealingPool
+{
+private:
+    struct TaskQueue
+    {
+        mutex lock;
+        deque<function<void()>> tasks;
+    };
+
+    vector<unique_ptr<TaskQueue>> queues;
+    vector<thread> workers;
+    mutex sleepLock;
+    condition_variable wake;
+    int queued;
+    bool stopping;
+    atomic<unsigned> nextQueue;
+
+    static inline thread_local WorkStealingPool *currentPool = nullptr;
+    static inline thread_local int currentWorker = -1;
+
+    int ownQueue() const { return currentPool == this ? currentWorker : -1; }
+
+    // Own deque from the back first, then every other deque from the front.
+    bool take(int self, function<void()> &task)
+    {
+        int count = (int)queues.size();
+        for (int k = 0; k < count; ++k)
+        {
+            int q = self >= 0 ? (self + k) % count : k;
+            TaskQueue &queue = *queues[q];
+            lock_guard<mutex> guard(queue.lock);
+            if (queue.tasks.empty())
+                continue;
+            if (q == self)
+            {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            lock_guard<mutex> sleeping(sleepLock);
+            queued--;
+            return true;
+        }
+        return false;
+    }
+
+    void workerLoop(int index)
+    {
+        currentPool = this;
+        currentWorker = index;
+        function<void()> task;
+        while (true)
+        {
+            if (take(index, task))
+            {
+                task();
+                task = nullptr;
+                continue;
+            }
+            unique_lock<mutex> sleeping(sleepLock);
+            wake.wait(sleeping, [&]
+                      { return stopping || queued > 0; });
+            if (stopping && queued == 0)
+                return;
+        }
+    }
+
+public:
+    explicit WorkStealingPool(unsigned threadCount) : queued(0), stopping(false), nextQueue(0)
+    {
+        if (threadCount == 0)
+            threadCount = 1;
+        for (unsigned i = 0; i < threadCount; ++i)
+            queues.push_back(make_unique<TaskQueue>());
+        for (unsigned i = 0; i < threadCount; ++i)
+            workers.emplace_back(&WorkStealingPool::workerLoop, this, (int)i);
+    }
+
+    ~WorkStealingPool()
+    {
+        {
+            lock_guard<mutex> sleeping(sleepLock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (thread &worker : workers)
+            worker.join();
+    }
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    unsigned size() const { return (unsigned)workers.size(); }
+
+    // Tasks submitted from a worker go on its own deque; others are spread
+    // round-robin.
+    void submit(function<void()> task)
+    {
+        int self = ownQueue();
+        int q = self >= 0 ? self : (int)(nextQueue++ % queues.size());
+        {
+            lock_guard<mutex> guard(queues[q]->lock);
+            queues[q]->tasks.push_back(std::move(task));
+        }
+        {
+            lock_guard<mutex> sleeping(sleepLock);
+            queued++;
+        }
+        wake.notify_one();
+    }
+
+    // Runs one pending task on the calling thread, if there is one. Lets a
+    // thread that waits on subtasks keep working instead of blocking.
+    bool runPending()
+    {
+        function<void()> task;
+        if (!take(ownQueue(), task))
+            return false;
+        task();
+        return true;
+    }
+};
+
+// Tracks a batch of tasks on a pool. wait() helps run pool tasks until the
+// whole batch has finished, so groups can nest inside pool tasks, and then
+// rethrows the first exception a task of the batch threw.
+class TaskGroup
+{
+private:
+    WorkStealingPool &pool;
+    mutex lock;
+    condition_variable finished;
+    int pending;
+    exception_ptr error;
+
+    // Runs pool tasks while there are any; once the queues are empty every
+    // task of the batch is already running elsewhere, so sleep until the
+    // last one finishes.
+    void finish()
+    {
+        unique_lock<mutex> guard(lock);
+        while (pending > 0)
+        {
+            guard.unlock();
+            bool ran = pool.runPending();
+            guard.lock();
+            if (!ran)
+                finished.wait(guard, [&]
+                              { return pending == 0; });
+        }
+    }
+
+public:
+    explicit TaskGroup(WorkStealingPool &pool) : pool(pool), pending(0) {}
+    // Never throws: an error nobody waited for is dropped.
+    ~TaskGroup() { finish(); }
+
+    void run(function<void()> task)
+    {
+        {
+            lock_guard<mutex> guard(lock);
+            pending++;
+        }
+        pool.submit([this, task]
+                    {
+            exception_ptr thrown;
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                thrown = current_exception();
+            }
+            // Notified under the lock: once it is released the waiter may
+            // return and destroy the group.
+            lock_guard<mutex> guard(lock);
+            if (thrown && !error)
+                error = thrown;
+            if (--pending == 0)
+                finished.notify_all(); });
+    }
+
+    void wait()
+    {
+        finish();
+        exception_ptr thrown;
+        {
+            lock_guard<mutex> guard(lock);
+            thrown = error;
+            error = nullptr;
+        }
+        if (thrown)
+            rethrow_exception(thrown);
+    }
+};
+
+// Ranges shorter than this are sorted by the caller's sequential sort.
+#define PARALLEL_SORT_CUTOFF (1 << 15)
+// Partition and merge work is cut into blocks of at least this many entries.
+#define PARALLEL_BLOCK_MIN (1 << 13)
+
+inline int parallelBlockCount(WorkStealingPool &pool, size_t length)
+{
+    size_t blocks = min<size_t>(pool.size() * 2, length / PARALLEL_BLOCK_MIN);
+    return blocks == 0 ? 1 : (int)blocks;
+}
+
+inline uint64_t medianOfThree(uint64_t a, uint64_t b, uint64_t c)
+{
+    if (a < b)
+        return b < c ? b : (a < c ? c : a);
+    return a < c ? a : (b < c ? c : b);
+}
+
+// Three-way partition of entries[low, high) around pivot, computed block by
+// block in parallel: every block counts its <, == and > entries, prefix sums
+// give each block its output slots, the blocks scatter into scratch and the
+// result is copied back. Returns the bounds of the == run as [lessEnd,
+// greaterBegin).
+inline void parallelPartition(vector<SortEntry> &entries, vector<SortEntry> &scratch, int low, int high,
+                              uint64_t pivot, WorkStealingPool &pool, int &lessEnd, int &greaterBegin)
+{
+    int length = high - low;
+    int blocks = parallelBlockCount(pool, length);
+    vector<int> less(blocks, 0), equal(blocks, 0), greater(blocks, 0);
+    auto blockBegin = [&](int b)
+    { return low + (int)((long long)length * b / blocks); };
+
+    {
+        TaskGroup group(pool);
+        for (int b = 0; b < blocks; ++b)
+        {
+            group.run([&, b]
+                      {
+                for (int i = blockBegin(b); i < blockBegin(b + 1); ++i)
+                {
+                    if (entries[i].key < pivot)
+                        less[b]++;
+                    else if (entries[i].key > pivot)
+                        greater[b]++;
+                    else
+                        equal[b]++;
+                } });
+        }
+    }
+
+    vector<int> lessAt(blocks), equalAt(blocks), greaterAt(blocks);
+    int totalLess = 0, totalEqual = 0;
+    for (int b = 0; b < blocks; ++b)
+    {
+        totalLess += less[b];
+        totalEqual += equal[b];
+    }
+    int nextLess = low, nextEqual = low + totalLess, nextGreater = low + totalLess + totalEqual;
+    for (int b = 0; b < blocks; ++b)
+    {
+        lessAt[b] = nextLess;
+        equalAt[b] = nextEqual;
+        greaterAt[b] = nextGreater;
+        nextLess += less[b];
+        nextEqual += equal[b];
+        nextGreater += greater[b];
+    }
+
+    {
+        TaskGroup group(pool);
+        for (int b = 0; b < blocks; ++b)
+        {
+            group.run([&, b]
+                      {
+                for (int i = blockBegin(b); i < blockBegin(b + 1); ++i)
+                {
+                    if (entries[i].key < pivot)
+                        scratch[lessAt[b]++] = entries[i];
+                    else if (entries[i].key > pivot)
+                        scratch[greaterAt[b]++] = entries[i];
+                    else
+                        scratch[equalAt[b]++] = entries[i];
+                } });
+        }
+    }
+
+    // Every block's slots may be written by any block, so copying back waits
+    // for the whole scatter.
+    {
+        TaskGroup group(pool);
+        for (int b = 0; b < blocks; ++b)
+        {
+            group.run([&, b]
+                      { copy(scratch.begin() + blockBegin(b), scratch.begin() + blockBegin(b + 1),
+                             entries.begin() + blockBegin(b)); });
+        }
+    }
+
+    lessEnd = low + totalLess;
+    greaterBegin = low + totalLess + totalEqual;
+}
+
+template <typename SequentialSort>
+void parallelQuickSortRange(vector<SortEntry> &entries, vector<SortEntry> &scratch, int low, int high,
+                            WorkStealingPool &pool, SequentialSort sequentialSort, int depthLimit)
+{
+    // Past the depth budget the pivots are going badly; the sequential sort
+    // carries its own worst-case guard.
+    if (high - low < PARALLEL_SORT_CUTOFF || depthLimit == 0)
+    {
+        sequentialSort(entries, low, high - 1);
+        return;
+    }
+
+    uint64_t pivot = medianOfThree(entries[low].key, entries[low + (high - low) / 2].key, entries[high - 1].key);
+    int lessEnd = low, greaterBegin = high;
+    parallelPartition(entries, scratch, low, high, pivot, pool, lessEnd, greaterBegin);
+
+    TaskGroup group(pool);
+    group.run([&, low, lessEnd]
+              { parallelQuickSortRange(entries, scratch, low, lessEnd, pool, sequentialSort, depthLimit - 1); });
+    parallelQuickSortRange(entries, scratch, greaterBegin, high, pool, sequentialSort, depthLimit - 1);
+    group.wait();
+}
+
+// Quicksort whose large ranges are partitioned in parallel and whose two
+// sides run as separate pool tasks. sequentialSort(entries, low, high) sorts
+// the inclusive range [low, high] and handles everything below the cutoff.
+template <typename SequentialSort>
+void parallelQuickSort(vector<SortEntry> &entries, WorkStealingPool &pool, SequentialSort sequentialSort)
+{
+    if ((int)entries.size() < PARALLEL_SORT_CUTOFF || pool.size() < 2)
+    {
+        sequentialSort(entries, 0, (int)entries.size() - 1);
+        return;
+    }
+    int depthLimit = 0;
+    for (size_t n = entries.size() / PARALLEL_SORT_CUTOFF; n > 0; n >>= 1)
+        depthLimit += 2;
+    vector<SortEntry> scratch(entries.size());
+    parallelQuickSortRange(entries, scratch, 0, (int)entries.size(), pool, sequentialSort, depthLimit);
+}
+
+// Number of entries of a that come first among the first diagonal outputs of
+// the stable merge of a and b (ties are taken from a).
+inline int mergeCoRank(int diagonal, const SortEntry *a, int aLength, const SortEntry *b, int bLength)
+{
+    int low = max(0, diagonal - bLength), high = min(diagonal, aLength);
+    while (low < high)
+    {
+        int i = low + (high - low) / 2;
+        int j = diagonal - i;
+        if (j > 0 && i < aLength && !(b[j - 1].key < a[i].key))
+            low = i + 1;
+        else
+            high = i;
+    }
+    return low;
+}
+
+// Stable merge of a and b into out. Large merges are cut along the merge
+// path into independent pieces that run as pool tasks.
+inline void parallelMerge(const SortEntry *a, int aLength, const SortEntry *b, int bLength, SortEntry *out,
+                          WorkStealingPool &pool)
+{
+    auto byKey = [](const SortEntry &x, const SortEntry &y)
+    { return x.key < y.key; };
+    int total = aLength + bLength;
+    int pieces = parallelBlockCount(pool, total);
+    if (pieces == 1)
+    {
+        merge(a, a + aLength, b, b + bLength, out, byKey);
+        return;
+    }
+
+    TaskGroup group(pool);
+    for (int p = 0; p < pieces; ++p)
+    {
+        group.run([=]
+                  {
+            int begin = (int)((long long)total * p / pieces);
+            int end = (int)((long long)total * (p + 1) / pieces);
+            int aBegin = mergeCoRank(begin, a, aLength, b, bLength);
+            int aEnd = mergeCoRank(end, a, aLength, b, bLength);
+            merge(a + aBegin, a + aEnd, b + (begin - aBegin), b + (end - aEnd), out + begin, byKey); });
+    }
+}
+
+// Stable parallel merge sort: runs are sorted concurrently, then merged
+// pairwise, every round's merges (and the pieces of each) in parallel.
+// Used for multi-key sorts, where ties must keep insertion order.
+inline void parallelMergeSort(vector<SortEntry> &entries, WorkStealingPool &pool)
+{
+    auto byKey = [](const SortEntry &x, const SortEntry &y)
+    { return x.key < y.key; };
+    int n = (int)entries.size();
+    int runs = parallelBlockCount(pool, n);
+    if (runs == 1 || pool.size() < 2)
+    {
+        stable_sort(entries.begin(), entries.end(), byKey);
+        return;
+    }
+
+    vector<int> bounds(runs + 1);
+    for (int r = 0; r <= runs; ++r)
+        bounds[r] = (int)((long long)n * r / runs);
+    {
+        TaskGroup group(pool);
+        for (int r = 0; r < runs; ++r)
+        {
+            group.run([&, r]
+                      { stable_sort(entries.begin() + bounds[r], entries.begin() + bounds[r + 1], byKey); });
+        }
+    }
+
+    vector<SortEntry> scratch(n);
+    vector<SortEntry> *from = &entries, *to = &scratch;
+    while (bounds.size() > 2)
+    {
+        vector<int> merged;
+        TaskGroup group(pool);
+        for (size_t r = 0; r + 1 < bounds.size(); r += 2)
+        {
+            merged.push_back(bounds[r]);
+            if (r + 2 < bounds.size())
+            {
+                int begin = bounds[r], middle = bounds[r + 1], end = bounds[r + 2];
+                group.run([=, &pool]
+                          { parallelMerge(from->data() + begin, middle - begin, from->data() + middle, end - middle,
+                                          to->data() + begin, pool); });
+            }
+            else
+            {
+                // Odd run out: carried over unchanged.
+                copy(from->begin() + bounds[r], from->begin() + bounds[r + 1], to->begin() + bounds[r]);
+            }
+        }
+        group.wait();
+        merged.push_back(n);
+        bounds.swap(merged);
+        swap(from, to);
+    }
+    if (from != &entries)
+        entries.swap(scratch);
+}
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef RESULTCURSOR_HPP
+#define RESULTCURSOR_HPP
+
+#include <vector>
+#include "TransactionTypeIndex.hpp"
+using namespace std;
+
+inline int postingRef(int position) { return position; }
+inline ListNode *postingRef(const NodePosting &posting) { return posting.node; }
+
+// Materialized result set: the matching rows (positions, or nodes for a
+// linked list) are collected once in store order, after which any page is
+// a constant-time slice.
+template <typename Ref>
+class ResultCursor
+{
+private:
+    vector<Ref> rows;
+    int pageSize;
+
+public:
+    explicit ResultCursor(int pageSize = 5) : pageSize(pageSize) {}
+
+    // Replaces the results with every row whose transaction_type code is
+    // flagged in matches.
+    template <typename Posting>
+    void collect(const TransactionTypeIndex<Posting> &index, const vector<char> &matches)
+    {
+        rows.clear();
+        rows.reserve(index.countMatching(matches));
+        index.forEachMatching(matches, [&](const Posting &posting)
+                              {
+            rows.push_back(postingRef(posting));
+            return true; });
+    }
+
+    // Replaces the results with the rows set in selection (a bitmap with
+    // count() and forEachSelected), in row order; refAt maps a row number to
+    // the reference kept.
+    template <typename Selection, typename RefAt>
+    void collectSelected(const Selection &selection, RefAt refAt)
+    {
+        rows.clear();
+        rows.reserve(selection.count());
+        selection.forEachSelected([&](int row)
+                                  { rows.push_back(refAt(row)); });
+    }
+
+    void add(const Ref &row) { rows.push_back(row); }
+    void clear() { rows.clear(); }
+
+    int size() const { return (int)rows.size(); }
+    int getPageSize() const { return pageSize; }
+    int pageCount() const { return ((int)rows.size() + pageSize - 1) / pageSize; }
+    const Ref &at(int i) const { return rows[i]; }
+
+    // Result slots [pageBegin, pageEnd) make up page; both are clamped to the
+    // result count, so a page past the end is simply empty.
+    int pageBegin(int page) const
+    {
+        long long first = (long long)page * pageSize;
+        return first < (long long)rows.size() ? (int)first : (int)rows.size();
+    }
+    int pageEnd(int page) const
+    {
+        long long last = ((long long)page + 1) * pageSize;
+        return last < (long long)rows.size() ? (int)last : (int)rows.size();
+    }
+};
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef SORTINDEX_HPP
+#define SORTINDEX_HPP
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "SortKey.hpp"
+using namespace std;
+
+// A row waiting to be ordered: its packed SortSpec key and its row id.
+struct SortEntry
+{
+    uint64_t key;
+    int row;
+};
+
+// Sorted view over a store whose rows never move: position k shows row
+// order[k]. An empty index is the insertion order, so reverting a sort, or
+// switching to an index built earlier, is a swap rather than a reshuffle.
+class SortIndex
+{
+private:
+    vector<int> order;
+    vector<SortField> fields;
+
+public:
+    SortIndex() {}
+
+    SortIndex(const vector<SortEntry> &sorted, const vector<SortField> &sortFields) : fields(sortFields)
+    {
+        order.reserve(sorted.size());
+        for (const SortEntry &entry : sorted)
+            order.push_back(entry.row);
+    }
+
+    bool isInsertionOrder() const { return fields.empty(); }
+    int rowAt(int position) const { return order.empty() ? position : order[position]; }
+    const vector<SortField> &getFields() const { return fields; }
+
+    void swap(SortIndex &other)
+    {
+        order.swap(other.order);
+        fields.swap(other.fields);
+    }
+
+    void clear()
+    {
+        order.clear();
+        order.shrink_to_fit();
+        fields.clear();
+    }
+
+    size_t bytes() const { return order.capacity() * sizeof(int); }
+};
+
+#endif
@@ -0,0 +1,146 @@
+#ifndef SORTKEY_HPP
+#define SORTKEY_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <initializer_list>
+#include "Transaction.hpp"
+using namespace std;
+
+// Dictionary-encoded fields a store can be sorted on.
+enum SortKey
+{
+    SORT_KEY_NONE,
+    SORT_KEY_LOCATION,
+    SORT_KEY_TRANSACTION_TYPE
+};
+
+// One level of a sort: the key and its direction.
+struct SortField
+{
+    SortKey key;
+    bool ascending;
+};
+
+inline const char *sortKeyName(SortKey key)
+{
+    switch (key)
+    {
+    case SORT_KEY_LOCATION:
+        return "Location";
+    case SORT_KEY_TRANSACTION_TYPE:
+        return "Transaction Type";
+    default:
+        return "None";
+    }
+}
+
+inline DictCode sortKeyCode(const Transaction &t, SortKey key)
+{
+    return key == SORT_KEY_TRANSACTION_TYPE ? t.transaction_type : t.location;
+}
+
+// Lexicographic rank of every code of key's dictionary.
+inline const vector<int> &sortKeyRanks(SortKey key)
+{
+    return key == SORT_KEY_TRANSACTION_TYPE ? fieldDictionaries.transactionType.getRanks()
+                                            : fieldDictionaries.location.getRanks();
+}
+
+#define MAX_SORT_FIELDS 2
+
+// Packs the dictionary ranks of up to MAX_SORT_FIELDS keys into one 64-bit
+// value, 32 bits per field with descending fields inverted, so rows compare
+// in the requested multi-key order with a single integer comparison.
+class SortSpec
+{
+private:
+    vector<SortField> fields;
+    vector<const vector<int> *> ranks;
+
+public:
+    SortSpec(initializer_list<SortField> levels) : fields(levels)
+    {
+        if (fields.size() > MAX_SORT_FIELDS)
+            fields.resize(MAX_SORT_FIELDS);
+        for (const SortField &field : fields)
+            ranks.push_back(&sortKeyRanks(field.key));
+    }
+
+    const vector<SortField> &getFields() const { return fields; }
+
+    // codeOf(key) returns the row's code for key.
+    template <typename CodeOf>
+    uint64_t keyOf(CodeOf codeOf) const
+    {
+        uint64_t packed = 0;
+        for (size_t f = 0; f < fields.size(); ++f)
+        {
+            const vector<int> &fieldRanks = *ranks[f];
+            uint32_t rank = (uint32_t)fieldRanks[codeOf(fields[f].key)];
+            if (!fields[f].ascending)
+                rank = (uint32_t)fieldRanks.size() - 1 - rank;
+            packed = (packed << 32) | rank;
+        }
+        return packed;
+    }
+
+    uint64_t keyOf(const Transaction &t) const
+    {
+        return keyOf([&](SortKey key)
+                     { return sortKeyCode(t, key); });
+    }
+
+    // e.g. "Location (A-Z), then Transaction Type (Z-A)".
+    string describe() const
+    {
+        string text;
+        for (size_t f = 0; f < fields.size(); ++f)
+        {
+            if (f > 0)
+                text += ", then ";
+            text += sortKeyName(fields[f].key);
+            text += fields[f].ascending ? " (A-Z)" : " (Z-A)";
+        }
+        return text;
+    }
+};
+
+// lower_bound/upper_bound of targetRank over n rows whose ranks, read
+// through rankAt(i), are sorted in the given direction. The matching rows
+// are [first, last).
+template <typename RankAt>
+void equalRankRange(int n, int targetRank, bool ascending, RankAt rankAt, int &first, int &last)
+{
+    auto before = [&](int rank, bool orEqual)
+    {
+        if (rank == targetRank)
+            return orEqual;
+        return ascending ? rank < targetRank : rank > targetRank;
+    };
+
+    int low = 0, high = n;
+    while (low < high)
+    {
+        int mid = low + (high - low) / 2;
+        if (before(rankAt(mid), false))
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    first = low;
+
+    high = n;
+    while (low < high)
+    {
+        int mid = low + (high - low) / 2;
+        if (before(rankAt(mid), true))
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    last = low;
+}
+
+#endif
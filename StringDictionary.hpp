@@ -0,0 +1,93 @@
+#ifndef STRINGDICTIONARY_HPP
+#define STRINGDICTIONARY_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+using namespace std;
+
+typedef unsigned int DictCode;
+
+// Maps every distinct value of a low-cardinality field to a small integer
+// code. Codes are handed out in first-seen order; getRanks() gives the
+// lexicographic position of each code so sorting can stay on integers.
+class StringDictionary
+{
+private:
+    vector<string> values;
+    map<string, DictCode, less<>> codes;
+    mutable vector<int> ranks;
+    mutable bool ranksDirty;
+
+public:
+    StringDictionary() : ranksDirty(false) {}
+
+    DictCode encode(string_view value)
+    {
+        auto it = codes.find(value);
+        if (it != codes.end())
+            return it->second;
+
+        DictCode code = (DictCode)values.size();
+        values.emplace_back(value);
+        codes.emplace(values.back(), code);
+        ranksDirty = true;
+        return code;
+    }
+
+    // Returns the code of value, or -1 if it has never been encoded.
+    int find(string_view value) const
+    {
+        auto it = codes.find(value);
+        return it == codes.end() ? -1 : (int)it->second;
+    }
+
+    const string &decode(DictCode code) const { return values[code]; }
+
+    int size() const { return (int)values.size(); }
+
+    const vector<int> &getRanks() const
+    {
+        if (ranksDirty || ranks.size() != values.size())
+        {
+            ranks.assign(values.size(), 0);
+            int rank = 0;
+            for (const auto &entry : codes)
+                ranks[entry.second] = rank++;
+            ranksDirty = false;
+        }
+        return ranks;
+    }
+
+    void clear()
+    {
+        values.clear();
+        codes.clear();
+        ranks.clear();
+        ranksDirty = false;
+    }
+};
+
+// One dictionary per encoded Transaction field.
+struct TransactionDictionaries
+{
+    StringDictionary transactionType;
+    StringDictionary merchantCategory;
+    StringDictionary location;
+    StringDictionary deviceUsed;
+    StringDictionary fraudType;
+    StringDictionary paymentChannel;
+
+    void clear()
+    {
+        transactionType.clear();
+        merchantCategory.clear();
+        location.clear();
+        deviceUsed.clear();
+        fraudType.clear();
+        paymentChannel.clear();
+    }
+};
+
+#endif
@@ -0,0 +1,220 @@
+#ifndef SYNTHETICDATAGENERATOR_HPP
+#define SYNTHETICDATAGENERATOR_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// Header of the fraud-detection CSV; generated rows follow the same 18
+// columns.
+inline const char *SYNTHETIC_CSV_HEADER =
+    "transaction_id,timestamp,sender_account,receiver_account,amount,transaction_type,"
+    "merchant_category,location,device_used,is_fraud,fraud_type,time_since_last_transaction,"
+    "spending_deviation_score,velocity_score,geo_anomaly_score,payment_channel,ip_address,device_hash\n";
+
+// Rows generated when no count is given, by --generate, --synthetic and
+// --bench alike.
+#define SYNTHETIC_DEFAULT_ROWS 500000
+
+// What to generate. The cardinalities count distinct values of a column: up
+// to the number of values in the sample dataset the real names are used
+// (8 cities, 4 types, the 4 loaded channels), beyond it numbered ones.
+// Channels past the fourth are not loaded, like any unknown channel.
+struct SyntheticDataSpec
+{
+    long long rows = SYNTHETIC_DEFAULT_ROWS;
+    uint64_t seed = 42;
+    int locations = 8;
+    int transactionTypes = 4;
+    int paymentChannels = 4;
+    double missingChannelRate = 0.2;
+    double fraudRate = 0.05;
+};
+
+// Deterministic generator of transactions shaped like the sample dataset.
+// Rows are produced in fixed-size blocks, each drawing from its own random
+// stream derived from the seed and the block number, so the data is the
+// same however the blocks are spread over threads.
+class SyntheticDataGenerator
+{
+private:
+    SyntheticDataSpec spec;
+    vector<string> locations, transactionTypes, paymentChannels;
+
+    // splitmix64: tiny state and good enough statistics for test data.
+    struct Random
+    {
+        uint64_t state;
+
+        uint64_t next()
+        {
+            uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+        uint64_t below(uint64_t n) { return next() % n; }
+        bool chance(double p) { return (next() >> 11) * (1.0 / 9007199254740992.0) < p; }
+    };
+
+    static vector<string> valuePool(const vector<string> &names, const string &prefix, int cardinality)
+    {
+        vector<string> pool;
+        for (int i = 0; i < cardinality; ++i)
+            pool.push_back(i < (int)names.size() ? names[i] : prefix + to_string(i + 1));
+        return pool;
+    }
+
+    static void appendUnsigned(string &out, uint64_t value, int width = 0)
+    {
+        char digits[20];
+        int length = 0;
+        do
+        {
+            digits[length++] = char('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        for (int i = length; i < width; ++i)
+            out += '0';
+        while (length > 0)
+            out += digits[--length];
+    }
+
+    // value / 10^decimals with exactly decimals digits after the point.
+    static void appendFixed(string &out, long long value, int decimals)
+    {
+        if (value < 0)
+        {
+            out += '-';
+            value = -value;
+        }
+        uint64_t scale = 1;
+        for (int i = 0; i < decimals; ++i)
+            scale *= 10;
+        appendUnsigned(out, (uint64_t)value / scale);
+        out += '.';
+        appendUnsigned(out, (uint64_t)value % scale, decimals);
+    }
+
+public:
+    static const long long BLOCK_ROWS = 1 << 16;
+
+    explicit SyntheticDataGenerator(const SyntheticDataSpec &spec)
+        : spec(spec),
+          locations(valuePool({"New York", "Tokyo", "London", "Sydney", "Singapore", "Toronto", "Dubai", "Berlin"},
+                              "City ", spec.locations)),
+          transactionTypes(valuePool({"withdrawal", "payment", "deposit", "transfer"}, "type_", spec.transactionTypes)),
+          paymentChannels(valuePool({"card", "ACH", "UPI", "wire_transfer"}, "channel_", spec.paymentChannels))
+    {
+    }
+
+    const SyntheticDataSpec &getSpec() const { return spec; }
+
+    long long blockCount() const { return (spec.rows + BLOCK_ROWS - 1) / BLOCK_ROWS; }
+
+    // Appends the CSV lines of one block (no header) to out.
+    void appendBlock(long long block, string &out) const
+    {
+        static const char *categories[] = {"other", "utilities", "entertainment", "grocery",
+                                           "online", "restaurant", "travel", "retail"};
+        static const char *devices[] = {"mobile", "web", "atm", "pos"};
+        static const char *fraudTypes[] = {"money_laundering", "account_takeover", "card_not_present"};
+
+        Random random{spec.seed ^ ((uint64_t)block * 0xD1B54A32D192ED03ULL)};
+        long long first = block * BLOCK_ROWS;
+        long long last = first + BLOCK_ROWS < spec.rows ? first + BLOCK_ROWS : spec.rows;
+        out.reserve(out.size() + (size_t)(last - first) * 200);
+        for (long long row = first; row < last; ++row)
+        {
+            bool fraud = random.chance(spec.fraudRate);
+
+            out += 'T';
+            appendUnsigned(out, (uint64_t)row + 1);
+            out += ",2023-";
+            appendUnsigned(out, 1 + random.below(12), 2);
+            out += '-';
+            appendUnsigned(out, 1 + random.below(28), 2);
+            out += 'T';
+            appendUnsigned(out, random.below(24), 2);
+            out += ':';
+            appendUnsigned(out, random.below(60), 2);
+            out += ':';
+            appendUnsigned(out, random.below(60), 2);
+            out += '.';
+            appendUnsigned(out, random.below(1000000), 6);
+            out += ",ACC";
+            appendUnsigned(out, random.below(1000000), 6);
+            out += ",ACC";
+            appendUnsigned(out, random.below(1000000), 6);
+            out += ',';
+            appendFixed(out, 1 + (long long)random.below(500000), 2);
+            out += ',';
+            out += transactionTypes[random.below(transactionTypes.size())];
+            out += ',';
+            out += categories[random.below(8)];
+            out += ',';
+            out += locations[random.below(locations.size())];
+            out += ',';
+            out += devices[random.below(4)];
+            out += fraud ? ",True," : ",False,";
+            if (fraud)
+                out += fraudTypes[random.below(3)];
+            out += ',';
+            // The sample leaves about a fifth of these empty.
+            if (!random.chance(0.2))
+                appendFixed(out, (long long)random.below(10000000001ULL) - 5000000000LL, 6);
+            out += ',';
+            appendFixed(out, (long long)random.below(1001) - 500, 2);
+            out += ',';
+            appendUnsigned(out, 1 + random.below(20));
+            out += ',';
+            appendFixed(out, (long long)random.below(10001), 4);
+            out += ',';
+            if (!random.chance(spec.missingChannelRate))
+                out += paymentChannels[random.below(paymentChannels.size())];
+            out += ",192.168.";
+            appendUnsigned(out, random.below(256));
+            out += '.';
+            appendUnsigned(out, random.below(256));
+            out += ",D";
+            appendUnsigned(out, random.below(10000000), 7);
+            out += '\n';
+        }
+    }
+
+    // Writes the header and every row to path, generating threadCount blocks
+    // at a time in parallel and writing them in order.
+    bool writeCsv(const string &path, unsigned threadCount) const
+    {
+        ofstream out(path, ios::out | ios::binary);
+        if (!out.is_open())
+            return false;
+        out << SYNTHETIC_CSV_HEADER;
+
+        if (threadCount == 0)
+            threadCount = 1;
+        vector<string> texts(threadCount);
+        for (long long round = 0; round < blockCount(); round += threadCount)
+        {
+            vector<thread> workers;
+            for (unsigned w = 0; w < threadCount && round + w < blockCount(); ++w)
+            {
+                workers.emplace_back([this, &texts, round, w]()
+                                     {
+                    texts[w].clear();
+                    appendBlock(round + w, texts[w]); });
+            }
+            for (size_t w = 0; w < workers.size(); ++w)
+            {
+                workers[w].join();
+                out.write(texts[w].data(), texts[w].size());
+            }
+        }
+        return out.good();
+    }
+};
+
+#endif
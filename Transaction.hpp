@@ -1,8 +1,10 @@
 #ifndef TRANSACTION_HPP
 #define TRANSACTION_HPP
 #include <string>
+#include "StringDictionary.hpp"
 using namespace std;
 
+// Low-cardinality fields are stored as codes into fieldDictionaries.
 struct Transaction
 {
     string transaction_id;
@@ -10,19 +12,38 @@ struct Transaction
     string sender_account;
     string receiver_account;
     double amount;
-    string transaction_type;
-    string merchant_category;
-    string location;
-    string device_used;
+    DictCode transaction_type;
+    DictCode merchant_category;
+    DictCode location;
+    DictCode device_used;
     bool is_fraud;
-    string fraud_type;
+    DictCode fraud_type;
     string time_since_last_transaction;
     string spending_deviation_score;
     double velocity_score;
     double geo_anomaly_score;
-    string payment_channel;
+    DictCode payment_channel;
     string ip_address;
     string device_hash;
 };
 
+inline TransactionDictionaries fieldDictionaries;
+
+// Heap bytes a string owns beyond the object itself: none while it fits the
+// small-string buffer, otherwise its capacity plus the terminator.
+inline size_t stringHeapBytes(const string &s)
+{
+    const char *object = reinterpret_cast<const char *>(&s);
+    bool inlineBuffer = s.data() >= object && s.data() < object + sizeof(string);
+    return inlineBuffer ? 0 : s.capacity() + 1;
+}
+
+inline size_t stringHeapBytes(const Transaction &t)
+{
+    return stringHeapBytes(t.transaction_id) + stringHeapBytes(t.timestamp) +
+           stringHeapBytes(t.sender_account) + stringHeapBytes(t.receiver_account) +
+           stringHeapBytes(t.time_since_last_transaction) + stringHeapBytes(t.spending_deviation_score) +
+           stringHeapBytes(t.ip_address) + stringHeapBytes(t.device_hash);
+}
+
 #endif
@@ -0,0 +1,422 @@
+#ifndef TRANSACTIONEXPORTER_HPP
+#define TRANSACTIONEXPORTER_HPP
+
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include "ArrayTransactionStore.hpp"
+#include "LinkedListTransactionStore.hpp"
+#include "ColumnarTransactionStore.hpp"
+#include "nlohmann_json.hpp"
+using namespace std;
+
+// One row as the exporter sees it: views into a Transaction or into the
+// columns of a columnar store, so no row is copied on the way out.
+struct TransactionView
+{
+    string_view transactionId;
+    string_view timestamp;
+    string_view senderAccount;
+    string_view receiverAccount;
+    double amount;
+    DictCode transactionType;
+    DictCode merchantCategory;
+    DictCode location;
+    DictCode deviceUsed;
+    bool isFraud;
+    DictCode fraudType;
+    string_view timeSinceLastTransaction;
+    string_view spendingDeviationScore;
+    double velocityScore;
+    double geoAnomalyScore;
+    DictCode paymentChannel;
+    string_view ipAddress;
+    string_view deviceHash;
+};
+
+inline TransactionView viewOf(const Transaction &t)
+{
+    return TransactionView{t.transaction_id, t.timestamp, t.sender_account, t.receiver_account, t.amount,
+                           t.transaction_type, t.merchant_category, t.location, t.device_used, t.is_fraud,
+                           t.fraud_type, t.time_since_last_transaction, t.spending_deviation_score,
+                           t.velocity_score, t.geo_anomaly_score, t.payment_channel, t.ip_address, t.device_hash};
+}
+
+inline TransactionView viewOf(const ColumnarTransactionStore &store, int row)
+{
+    return TransactionView{store.getTransactionIdColumn()[row],
+                           store.getTimestampColumn()[row],
+                           store.getSenderAccountColumn()[row],
+                           store.getReceiverAccountColumn()[row],
+                           store.getAmountColumn()[row],
+                           store.getTransactionTypeColumn()[row],
+                           store.getMerchantCategoryColumn()[row],
+                           store.getLocationColumn()[row],
+                           store.getDeviceUsedColumn()[row],
+                           store.getFraudFlagColumn()[row] != 0,
+                           store.getFraudTypeColumn()[row],
+                           store.getTimeSinceLastTransactionColumn()[row],
+                           store.getSpendingDeviationScoreColumn()[row],
+                           store.getVelocityScoreColumn()[row],
+                           store.getGeoAnomalyScoreColumn()[row],
+                           store.getPaymentChannelColumn()[row],
+                           store.getIpAddressColumn()[row],
+                           store.getDeviceHashColumn()[row]};
+}
+
+// Export file formats. The JSON ones share the record layout below; the
+// binary ones are streams of CBOR or MessagePack maps, one per row, that a
+// reader decodes item by item.
+enum ExportFormat
+{
+    EXPORT_JSON_PRETTY,
+    EXPORT_JSON_COMPACT,
+    EXPORT_NDJSON,
+    EXPORT_CBOR,
+    EXPORT_MSGPACK
+};
+
+inline const char *exportFormatName(ExportFormat format)
+{
+    switch (format)
+    {
+    case EXPORT_JSON_COMPACT:
+        return "Compact JSON";
+    case EXPORT_NDJSON:
+        return "NDJSON";
+    case EXPORT_CBOR:
+        return "CBOR";
+    case EXPORT_MSGPACK:
+        return "MessagePack";
+    default:
+        return "JSON";
+    }
+}
+
+inline const char *exportFileExtension(ExportFormat format)
+{
+    switch (format)
+    {
+    case EXPORT_JSON_COMPACT:
+        return ".min.json";
+    case EXPORT_NDJSON:
+        return ".ndjson";
+    case EXPORT_CBOR:
+        return ".cbor";
+    case EXPORT_MSGPACK:
+        return ".msgpack";
+    default:
+        return ".json";
+    }
+}
+
+// Appends output to a large in-memory buffer and hands it to the file in
+// big writes, instead of one formatted stream insertion per field. Has the
+// JSON value formatters; binary records go through raw().
+class ExportWriter
+{
+private:
+    ofstream &out;
+    string buffer;
+    size_t flushAt;
+
+public:
+    explicit ExportWriter(ofstream &out, size_t bufferBytes = 1 << 20) : out(out), flushAt(bufferBytes)
+    {
+        buffer.reserve(bufferBytes + 4096);
+    }
+    ~ExportWriter() { flush(); }
+
+    ExportWriter(const ExportWriter &) = delete;
+    ExportWriter &operator=(const ExportWriter &) = delete;
+
+    void flush()
+    {
+        out.write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+
+    // Callers invoke this between records so the buffer never grows past
+    // flushAt by more than one record.
+    void flushIfFull()
+    {
+        if (buffer.size() >= flushAt)
+            flush();
+    }
+
+    void raw(string_view text) { buffer.append(text.data(), text.size()); }
+    void raw(char c) { buffer.push_back(c); }
+
+    // Quoted string with ", \ and control characters escaped. Runs of plain
+    // characters are copied in one append.
+    void quoted(string_view text)
+    {
+        static const char hex[] = "0123456789abcdef";
+        buffer.push_back('"');
+        size_t plain = 0;
+        for (size_t i = 0; i < text.size(); ++i)
+        {
+            unsigned char c = (unsigned char)text[i];
+            if (c >= 0x20 && c != '"' && c != '\\')
+                continue;
+            buffer.append(text.data() + plain, i - plain);
+            plain = i + 1;
+            buffer.push_back('\\');
+            switch (c)
+            {
+            case '"':
+                buffer.push_back('"');
+                break;
+            case '\\':
+                buffer.push_back('\\');
+                break;
+            case '\b':
+                buffer.push_back('b');
+                break;
+            case '\f':
+                buffer.push_back('f');
+                break;
+            case '\n':
+                buffer.push_back('n');
+                break;
+            case '\r':
+                buffer.push_back('r');
+                break;
+            case '\t':
+                buffer.push_back('t');
+                break;
+            default:
+                buffer.append("u00");
+                buffer.push_back(hex[c >> 4]);
+                buffer.push_back(hex[c & 0xF]);
+            }
+        }
+        buffer.append(text.data() + plain, text.size() - plain);
+        buffer.push_back('"');
+    }
+
+    // Shortest text that reads back as exactly value, formatted straight into
+    // the buffer without locale or stream state. JSON has no NaN or infinity,
+    // so those become null.
+    void number(double value)
+    {
+        if (!isfinite(value))
+        {
+            buffer.append("null");
+            return;
+        }
+        char digits[32];
+        to_chars_result result = to_chars(digits, digits + sizeof(digits), value);
+        buffer.append(digits, result.ptr - digits);
+    }
+
+    void boolean(bool value) { buffer.append(value ? "true" : "false"); }
+};
+
+// The one record serializer: hands every field of t to writer, in the
+// field order of the CSV, with dictionary codes decoded.
+template <typename FieldWriter>
+void writeRecordFields(FieldWriter &writer, const TransactionView &t)
+{
+    writer.field("transaction_id"sv, t.transactionId);
+    writer.field("timestamp"sv, t.timestamp);
+    writer.field("sender_account"sv, t.senderAccount);
+    writer.field("receiver_account"sv, t.receiverAccount);
+    writer.field("amount"sv, t.amount);
+    writer.field("transaction_type"sv, fieldDictionaries.transactionType.decode(t.transactionType));
+    writer.field("merchant_category"sv, fieldDictionaries.merchantCategory.decode(t.merchantCategory));
+    writer.field("location"sv, fieldDictionaries.location.decode(t.location));
+    writer.field("device_used"sv, fieldDictionaries.deviceUsed.decode(t.deviceUsed));
+    writer.field("is_fraud"sv, t.isFraud);
+    writer.field("fraud_type"sv, fieldDictionaries.fraudType.decode(t.fraudType));
+    writer.field("time_since_last_transaction"sv, t.timeSinceLastTransaction);
+    writer.field("spending_deviation_score"sv, t.spendingDeviationScore);
+    writer.field("velocity_score"sv, t.velocityScore);
+    writer.field("geo_anomaly_score"sv, t.geoAnomalyScore);
+    writer.field("payment_channel"sv, fieldDictionaries.paymentChannel.decode(t.paymentChannel));
+    writer.field("ip_address"sv, t.ipAddress);
+    writer.field("device_hash"sv, t.deviceHash);
+}
+
+// Writes records as JSON objects, pretty-printed (two-space indent, one
+// field per line) or compact (no whitespace at all). The separator and
+// quoted key in front of each value are built on the first record and
+// reused, so every field costs one append plus its value.
+class JsonRecordWriter
+{
+private:
+    ExportWriter &out;
+    bool pretty;
+    vector<string> prefixes;
+    size_t fieldIndex;
+
+    void name(string_view key)
+    {
+        if (fieldIndex == prefixes.size())
+        {
+            // Keys are fixed identifiers; nothing in them needs escaping.
+            string prefix = fieldIndex == 0 ? "" : ",";
+            prefix += pretty ? "\n    \"" : "\"";
+            prefix.append(key.data(), key.size());
+            prefix += pretty ? "\": " : "\":";
+            prefixes.push_back(prefix);
+        }
+        out.raw(prefixes[fieldIndex++]);
+    }
+
+public:
+    JsonRecordWriter(ExportWriter &out, bool pretty) : out(out), pretty(pretty), fieldIndex(0) {}
+
+    void field(string_view key, string_view value)
+    {
+        name(key);
+        out.quoted(value);
+    }
+    void field(string_view key, double value)
+    {
+        name(key);
+        out.number(value);
+    }
+    void field(string_view key, bool value)
+    {
+        name(key);
+        out.boolean(value);
+    }
+
+    void write(const TransactionView &t)
+    {
+        out.raw(pretty ? "  {" : "{");
+        fieldIndex = 0;
+        writeRecordFields(*this, t);
+        out.raw(pretty ? "\n  }" : "}");
+    }
+};
+
+// Writes records as CBOR or MessagePack maps through the vendored
+// nlohmann::json encoders. The same ordered object is refilled for every
+// row, so its keys and string buffers are allocated once.
+class BinaryRecordWriter
+{
+private:
+    ExportWriter &out;
+    bool cbor;
+    nlohmann::ordered_json record;
+    size_t fieldIndex;
+    string encoded;
+
+    // The first record adds each key; later ones overwrite the values in
+    // place by position, since every record has the same fields in the same
+    // order, so no field pays for a key lookup.
+    nlohmann::ordered_json &slot(string_view key)
+    {
+        nlohmann::ordered_json::object_t &fields = record.get_ref<nlohmann::ordered_json::object_t &>();
+        if (fieldIndex == fields.size())
+            fields.emplace_back(string(key), nullptr);
+        return (fields.begin() + fieldIndex++)->second;
+    }
+
+public:
+    BinaryRecordWriter(ExportWriter &out, bool cbor)
+        : out(out), cbor(cbor), record(nlohmann::ordered_json::object()), fieldIndex(0) {}
+
+    void field(string_view key, string_view value)
+    {
+        nlohmann::ordered_json &current = slot(key);
+        if (current.is_string())
+            current.get_ref<string &>().assign(value.data(), value.size());
+        else
+            current = string(value);
+    }
+    void field(string_view key, double value) { slot(key) = value; }
+    void field(string_view key, bool value) { slot(key) = value; }
+
+    void write(const TransactionView &t)
+    {
+        fieldIndex = 0;
+        writeRecordFields(*this, t);
+        encoded.clear();
+        if (cbor)
+            nlohmann::ordered_json::to_cbor(record, encoded);
+        else
+            nlohmann::ordered_json::to_msgpack(record, encoded);
+        out.raw(encoded);
+    }
+};
+
+// Writes the rows forEachRow produces in the given format. forEachRow(emit)
+// must call emit(view) once per row, in export order. Returns false if the
+// file could not be written.
+template <typename ForEachRow>
+bool writeExport(const string &filename, ExportFormat format, ForEachRow forEachRow)
+{
+    bool binary = format == EXPORT_CBOR || format == EXPORT_MSGPACK;
+    ofstream out(filename, binary ? ios::out | ios::binary : ios::out);
+    if (!out.is_open())
+        return false;
+
+    {
+        ExportWriter writer(out);
+        if (binary)
+        {
+            BinaryRecordWriter records(writer, format == EXPORT_CBOR);
+            forEachRow([&](const TransactionView &view)
+                       {
+                records.write(view);
+                writer.flushIfFull(); });
+        }
+        else
+        {
+            // Pretty and compact JSON are arrays; NDJSON is one compact
+            // object per line.
+            bool pretty = format == EXPORT_JSON_PRETTY;
+            bool array = format != EXPORT_NDJSON;
+            const char *separator = format == EXPORT_NDJSON ? "\n" : pretty ? ",\n"
+                                                                            : ",";
+            JsonRecordWriter records(writer, pretty);
+            bool first = true;
+            if (array)
+                writer.raw(pretty ? "[\n" : "[");
+            forEachRow([&](const TransactionView &view)
+                       {
+                if (!first)
+                    writer.raw(separator);
+                first = false;
+                records.write(view);
+                writer.flushIfFull(); });
+            if (array)
+                writer.raw(pretty && !first ? "\n]\n" : "]\n");
+            else if (!first)
+                writer.raw('\n');
+        }
+    }
+    return out.good();
+}
+
+// Rows are exported in view order (the active sort, if any).
+inline bool exportStore(const string &filename, const ArrayTransactionStore &store, ExportFormat format)
+{
+    return writeExport(filename, format, [&](auto emit)
+                       {
+        for (int position = 0; position < store.size(); ++position)
+            emit(viewOf(store.getRef(store.rowAt(position)))); });
+}
+
+inline bool exportStore(const string &filename, const LinkedListTransactionStore &store, ExportFormat format)
+{
+    return writeExport(filename, format, [&](auto emit)
+                       {
+        for (ListNode *node = store.getHead(); node; node = node->next)
+            emit(viewOf(node->data)); });
+}
+
+inline bool exportStore(const string &filename, const ColumnarTransactionStore &store, ExportFormat format)
+{
+    return writeExport(filename, format, [&](auto emit)
+                       {
+        for (int position = 0; position < store.size(); ++position)
+            emit(viewOf(store, store.rowAt(position))); });
+}
+
+#endif
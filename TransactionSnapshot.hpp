@@ -0,0 +1,420 @@
+#ifndef TRANSACTIONSNAPSHOT_HPP
+#define TRANSACTIONSNAPSHOT_HPP
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Transaction.hpp"
+#include "MappedFile.hpp"
+using namespace std;
+
+#define SNAPSHOT_VERSION 2
+#define SNAPSHOT_CHANNELS 4
+#define SNAPSHOT_TEXT_FIELDS 8
+#define SNAPSHOT_CODE_FIELDS 6
+
+// Binary image of the loaded channel stores (native byte order). After the
+// header, every section starts on an 8-byte boundary:
+//   string table   uint64 offsets[stringCount + 1], then the string bytes
+//   dictionaries   6 x (uint64 count, uint32 stringIds[count])
+//   text columns   8 x uint32 stringIds[rowCount]
+//   code columns   6 x uint32 codes[rowCount]
+//   numeric        amount, velocity_score, geo_anomaly_score as double[rowCount]
+//   is_fraud       uint8[rowCount]
+// Rows are grouped by channel: channelRows[c] .. channelRows[c + 1] holds
+// card, ach, upi and wire in that order. checksum covers the whole payload.
+struct SnapshotHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t sourceSize;
+    int64_t sourceModified;
+    uint64_t rowCount;
+    uint64_t channelRows[SNAPSHOT_CHANNELS + 1];
+    uint64_t stringCount;
+    uint64_t stringBytesOffset;
+    uint64_t dictionaryOffset;
+    uint64_t columnsOffset;
+    uint64_t payloadSize;
+    uint64_t checksum;
+};
+
+static const char SNAPSHOT_MAGIC[8] = {'T', 'X', 'S', 'N', 'A', 'P', '\0', '\0'};
+
+// FNV-1a over 64-bit words; size must be a multiple of 8.
+inline uint64_t snapshotChecksum(const char *data, size_t size)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i + 8 <= size; i += 8)
+    {
+        uint64_t word;
+        memcpy(&word, data + i, 8);
+        hash = (hash ^ word) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+inline void padTo8(vector<char> &buffer)
+{
+    while (buffer.size() % 8 != 0)
+        buffer.push_back('\0');
+}
+
+template <typename T>
+void appendPod(vector<char> &buffer, const T *values, size_t count)
+{
+    const char *bytes = (const char *)values;
+    buffer.insert(buffer.end(), bytes, bytes + count * sizeof(T));
+}
+
+// Collects rows channel by channel and writes the snapshot in one go.
+class SnapshotWriter
+{
+private:
+    vector<uint64_t> stringOffsets;
+    vector<char> stringBytes;
+    vector<uint32_t> textColumns[SNAPSHOT_TEXT_FIELDS];
+    vector<uint32_t> codeColumns[SNAPSHOT_CODE_FIELDS];
+    vector<double> amounts, velocityScores, geoAnomalyScores;
+    vector<uint8_t> fraudFlags;
+    uint64_t channelRows[SNAPSHOT_CHANNELS + 1];
+    int currentChannel;
+
+    // Ids are only meaningful while the table stays within uint32 range;
+    // save() refuses to write a table that outgrew it.
+    uint32_t addString(const string &value)
+    {
+        stringBytes.insert(stringBytes.end(), value.begin(), value.end());
+        stringOffsets.push_back(stringBytes.size());
+        return (uint32_t)(stringOffsets.size() - 2);
+    }
+
+public:
+    SnapshotWriter() : stringOffsets(1, 0), currentChannel(-1)
+    {
+        memset(channelRows, 0, sizeof(channelRows));
+    }
+
+    // Channels must be started in order 0..SNAPSHOT_CHANNELS-1.
+    void beginChannel(int channel)
+    {
+        uint64_t rows = fraudFlags.size();
+        for (int c = currentChannel + 1; c <= channel; ++c)
+            channelRows[c] = rows;
+        currentChannel = channel;
+    }
+
+    void addRow(const Transaction &t)
+    {
+        textColumns[0].push_back(addString(t.transaction_id));
+        textColumns[1].push_back(addString(t.timestamp));
+        textColumns[2].push_back(addString(t.sender_account));
+        textColumns[3].push_back(addString(t.receiver_account));
+        textColumns[4].push_back(addString(t.time_since_last_transaction));
+        textColumns[5].push_back(addString(t.spending_deviation_score));
+        textColumns[6].push_back(addString(t.ip_address));
+        textColumns[7].push_back(addString(t.device_hash));
+        codeColumns[0].push_back(t.transaction_type);
+        codeColumns[1].push_back(t.merchant_category);
+        codeColumns[2].push_back(t.location);
+        codeColumns[3].push_back(t.device_used);
+        codeColumns[4].push_back(t.fraud_type);
+        codeColumns[5].push_back(t.payment_channel);
+        amounts.push_back(t.amount);
+        velocityScores.push_back(t.velocity_score);
+        geoAnomalyScores.push_back(t.geo_anomaly_score);
+        fraudFlags.push_back(t.is_fraud ? 1 : 0);
+    }
+
+    // Writes to path + ".tmp" and renames it over path, which replaces the
+    // old snapshot atomically: readers see the old file or the new one, and
+    // a failed save leaves the old one in place.
+    bool save(const string &path, const TransactionDictionaries &dictionaries,
+              uint64_t sourceSize, int64_t sourceModified)
+    {
+        beginChannel(SNAPSHOT_CHANNELS);
+        uint64_t rowCount = fraudFlags.size();
+
+        const StringDictionary *dicts[SNAPSHOT_CODE_FIELDS] = {
+            &dictionaries.transactionType, &dictionaries.merchantCategory, &dictionaries.location,
+            &dictionaries.deviceUsed, &dictionaries.fraudType, &dictionaries.paymentChannel};
+        vector<uint32_t> dictionaryIds[SNAPSHOT_CODE_FIELDS];
+        for (int d = 0; d < SNAPSHOT_CODE_FIELDS; ++d)
+        {
+            for (int code = 0; code < dicts[d]->size(); ++code)
+                dictionaryIds[d].push_back(addString(dicts[d]->decode(code)));
+        }
+        if (stringOffsets.size() > UINT32_MAX || stringBytes.size() > UINT32_MAX)
+            return false;
+
+        SnapshotHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+        header.version = SNAPSHOT_VERSION;
+        header.headerSize = sizeof(SnapshotHeader);
+        header.sourceSize = sourceSize;
+        header.sourceModified = sourceModified;
+        header.rowCount = rowCount;
+        memcpy(header.channelRows, channelRows, sizeof(channelRows));
+        header.stringCount = stringOffsets.size() - 1;
+
+        vector<char> payload;
+        appendPod(payload, stringOffsets.data(), stringOffsets.size());
+        header.stringBytesOffset = payload.size();
+        appendPod(payload, stringBytes.data(), stringBytes.size());
+        padTo8(payload);
+
+        header.dictionaryOffset = payload.size();
+        for (int d = 0; d < SNAPSHOT_CODE_FIELDS; ++d)
+        {
+            uint64_t count = dictionaryIds[d].size();
+            appendPod(payload, &count, 1);
+            appendPod(payload, dictionaryIds[d].data(), dictionaryIds[d].size());
+            padTo8(payload);
+        }
+
+        header.columnsOffset = payload.size();
+        for (int c = 0; c < SNAPSHOT_TEXT_FIELDS; ++c)
+        {
+            appendPod(payload, textColumns[c].data(), rowCount);
+            padTo8(payload);
+        }
+        for (int c = 0; c < SNAPSHOT_CODE_FIELDS; ++c)
+        {
+            appendPod(payload, codeColumns[c].data(), rowCount);
+            padTo8(payload);
+        }
+        appendPod(payload, amounts.data(), rowCount);
+        appendPod(payload, velocityScores.data(), rowCount);
+        appendPod(payload, geoAnomalyScores.data(), rowCount);
+        appendPod(payload, fraudFlags.data(), rowCount);
+        padTo8(payload);
+
+        header.payloadSize = payload.size();
+        header.checksum = snapshotChecksum(payload.data(), payload.size());
+
+        string tempPath = path + ".tmp";
+        FILE *out = fopen(tempPath.c_str(), "wb");
+        if (!out)
+            return false;
+        bool ok = fwrite(&header, sizeof(header), 1, out) == 1 &&
+                  (payload.empty() || fwrite(payload.data(), payload.size(), 1, out) == 1);
+        ok = (fclose(out) == 0) && ok;
+        if (!ok)
+        {
+            remove(tempPath.c_str());
+            return false;
+        }
+#ifdef _WIN32
+        bool replaced = MoveFileExA(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+        bool replaced = rename(tempPath.c_str(), path.c_str()) == 0;
+#endif
+        if (!replaced)
+            remove(tempPath.c_str());
+        return replaced;
+    }
+};
+
+// Maps a snapshot and hands rows back without parsing any text.
+class SnapshotReader
+{
+private:
+    MappedFile file;
+    SnapshotHeader header;
+    const char *payload;
+    const uint64_t *stringOffsets;
+    const char *stringBytes;
+    const uint32_t *textColumns[SNAPSHOT_TEXT_FIELDS];
+    const uint32_t *codeColumns[SNAPSHOT_CODE_FIELDS];
+    const double *amounts;
+    const double *velocityScores;
+    const double *geoAnomalyScores;
+    const uint8_t *fraudFlags;
+
+    static size_t padded(size_t bytes) { return (bytes + 7) & ~(size_t)7; }
+
+    string stringAt(uint32_t id) const
+    {
+        return string(stringBytes + stringOffsets[id], stringOffsets[id + 1] - stringOffsets[id]);
+    }
+
+    // The dictionaries sit inside [dictionaryOffset, columnsOffset): every
+    // string id must name a string and no dictionary may repeat a value, or
+    // re-encoding would hand out different codes. Their sizes go to counts.
+    bool validDictionaries(uint64_t (&counts)[SNAPSHOT_CODE_FIELDS]) const
+    {
+        uint64_t at = header.dictionaryOffset;
+        for (int d = 0; d < SNAPSHOT_CODE_FIELDS; ++d)
+        {
+            uint64_t count;
+            if (at > header.columnsOffset || header.columnsOffset - at < sizeof(count))
+                return false;
+            memcpy(&count, payload + at, sizeof(count));
+            if (count > (header.columnsOffset - at - sizeof(count)) / sizeof(uint32_t))
+                return false;
+            const uint32_t *ids = (const uint32_t *)(payload + at + sizeof(count));
+            vector<string_view> values;
+            values.reserve(count);
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                if (ids[i] >= header.stringCount)
+                    return false;
+                values.emplace_back(stringBytes + stringOffsets[ids[i]], stringOffsets[ids[i] + 1] - stringOffsets[ids[i]]);
+            }
+            sort(values.begin(), values.end());
+            if (adjacent_find(values.begin(), values.end()) != values.end())
+                return false;
+            counts[d] = count;
+            at += padded(sizeof(count) + count * sizeof(uint32_t));
+        }
+        return true;
+    }
+
+public:
+    SnapshotReader() : payload(nullptr) {}
+
+    // Fails when the file is missing, corrupt, from another format version,
+    // or was built from a different source file. The checksum
+    // only catches accidental damage, so every offset, string id and code is
+    // also checked here once; row() and restoreDictionaries() rely on it.
+    bool open(const string &path, uint64_t sourceSize, int64_t sourceModified)
+    {
+        if (!file.open(path) || file.size() < sizeof(SnapshotHeader))
+            return false;
+
+        memcpy(&header, file.data(), sizeof(header));
+        if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 ||
+            header.version != SNAPSHOT_VERSION || header.headerSize != sizeof(SnapshotHeader))
+            return false;
+        if (header.sourceSize != sourceSize || header.sourceModified != sourceModified)
+            return false;
+        if (file.size() != sizeof(SnapshotHeader) + header.payloadSize)
+            return false;
+
+        payload = file.data() + sizeof(SnapshotHeader);
+        if (snapshotChecksum(payload, header.payloadSize) != header.checksum)
+            return false;
+
+        // Sections in order, 8-byte aligned, inside the payload.
+        uint64_t strings = header.stringCount;
+        if (strings >= UINT32_MAX || (strings + 1) * sizeof(uint64_t) > header.stringBytesOffset ||
+            header.stringBytesOffset > header.dictionaryOffset || header.dictionaryOffset > header.columnsOffset ||
+            header.columnsOffset > header.payloadSize || header.dictionaryOffset % 8 != 0 || header.columnsOffset % 8 != 0)
+            return false;
+
+        stringOffsets = (const uint64_t *)payload;
+        stringBytes = payload + header.stringBytesOffset;
+        if (stringOffsets[0] != 0 || stringOffsets[strings] > header.dictionaryOffset - header.stringBytesOffset)
+            return false;
+        for (uint64_t id = 0; id < strings; ++id)
+        {
+            if (stringOffsets[id] > stringOffsets[id + 1])
+                return false;
+        }
+
+        uint64_t dictionaryCounts[SNAPSHOT_CODE_FIELDS];
+        if (!validDictionaries(dictionaryCounts))
+            return false;
+
+        // The stores count rows in an int.
+        uint64_t rows = header.rowCount;
+        if (rows > INT_MAX || header.channelRows[0] != 0 || header.channelRows[SNAPSHOT_CHANNELS] != rows)
+            return false;
+        for (int c = 0; c < SNAPSHOT_CHANNELS; ++c)
+        {
+            if (header.channelRows[c] > header.channelRows[c + 1])
+                return false;
+        }
+        uint64_t columnBytes = SNAPSHOT_TEXT_FIELDS * padded(rows * 4) + SNAPSHOT_CODE_FIELDS * padded(rows * 4) +
+                               rows * (3 * sizeof(double) + 1);
+        if (columnBytes > header.payloadSize - header.columnsOffset)
+            return false;
+
+        const char *cursor = payload + header.columnsOffset;
+        for (int c = 0; c < SNAPSHOT_TEXT_FIELDS; ++c, cursor += padded(rows * 4))
+            textColumns[c] = (const uint32_t *)cursor;
+        for (int c = 0; c < SNAPSHOT_CODE_FIELDS; ++c, cursor += padded(rows * 4))
+            codeColumns[c] = (const uint32_t *)cursor;
+        amounts = (const double *)cursor;
+        velocityScores = amounts + rows;
+        geoAnomalyScores = velocityScores + rows;
+        fraudFlags = (const uint8_t *)(geoAnomalyScores + rows);
+
+        for (int c = 0; c < SNAPSHOT_TEXT_FIELDS; ++c)
+        {
+            for (uint64_t i = 0; i < rows; ++i)
+            {
+                if (textColumns[c][i] >= strings)
+                    return false;
+            }
+        }
+        for (int c = 0; c < SNAPSHOT_CODE_FIELDS; ++c)
+        {
+            for (uint64_t i = 0; i < rows; ++i)
+            {
+                if (codeColumns[c][i] >= dictionaryCounts[c])
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    // Re-encoding in stored order reproduces the original codes.
+    void restoreDictionaries(TransactionDictionaries &dictionaries) const
+    {
+        StringDictionary *dicts[SNAPSHOT_CODE_FIELDS] = {
+            &dictionaries.transactionType, &dictionaries.merchantCategory, &dictionaries.location,
+            &dictionaries.deviceUsed, &dictionaries.fraudType, &dictionaries.paymentChannel};
+        const char *cursor = payload + header.dictionaryOffset;
+        for (int d = 0; d < SNAPSHOT_CODE_FIELDS; ++d)
+        {
+            uint64_t count;
+            memcpy(&count, cursor, sizeof(count));
+            const uint32_t *ids = (const uint32_t *)(cursor + sizeof(count));
+            dicts[d]->clear();
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                uint32_t id = ids[i];
+                dicts[d]->encode(string_view(stringBytes + stringOffsets[id], stringOffsets[id + 1] - stringOffsets[id]));
+            }
+            cursor += padded(sizeof(count) + count * sizeof(uint32_t));
+        }
+    }
+
+    uint64_t channelBegin(int channel) const { return header.channelRows[channel]; }
+    uint64_t channelEnd(int channel) const { return header.channelRows[channel + 1]; }
+    uint64_t rowCount() const { return header.rowCount; }
+
+    Transaction row(uint64_t index) const
+    {
+        Transaction t;
+        t.transaction_id = stringAt(textColumns[0][index]);
+        t.timestamp = stringAt(textColumns[1][index]);
+        t.sender_account = stringAt(textColumns[2][index]);
+        t.receiver_account = stringAt(textColumns[3][index]);
+        t.time_since_last_transaction = stringAt(textColumns[4][index]);
+        t.spending_deviation_score = stringAt(textColumns[5][index]);
+        t.ip_address = stringAt(textColumns[6][index]);
+        t.device_hash = stringAt(textColumns[7][index]);
+        t.transaction_type = codeColumns[0][index];
+        t.merchant_category = codeColumns[1][index];
+        t.location = codeColumns[2][index];
+        t.device_used = codeColumns[3][index];
+        t.fraud_type = codeColumns[4][index];
+        t.payment_channel = codeColumns[5][index];
+        t.amount = amounts[index];
+        t.velocity_score = velocityScores[index];
+        t.geo_anomaly_score = geoAnomalyScores[index];
+        t.is_fraud = fraudFlags[index] != 0;
+        return t;
+    }
+};
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef TRANSACTIONTYPEINDEX_HPP
+#define TRANSACTIONTYPEINDEX_HPP
+
+#include <vector>
+#include "StringDictionary.hpp"
+using namespace std;
+
+struct ListNode;
+
+// Posting for stores without random access: the node itself plus its
+// position, so postings of different codes can still be merged in list order.
+struct NodePosting
+{
+    int position;
+    ListNode *node;
+};
+
+inline int postingPosition(int position) { return position; }
+inline int postingPosition(const NodePosting &posting) { return posting.position; }
+
+// Inverted index from transaction_type code to the rows carrying it. Each
+// posting list is in store order, so a search only touches its own matches.
+template <typename Posting>
+class TransactionTypeIndex
+{
+private:
+    vector<vector<Posting>> postings;
+
+public:
+    void add(DictCode code, const Posting &posting)
+    {
+        if (code >= postings.size())
+            postings.resize(code + 1);
+        postings[code].push_back(posting);
+    }
+
+    const vector<Posting> &rowsFor(DictCode code) const
+    {
+        static const vector<Posting> none;
+        return code < postings.size() ? postings[code] : none;
+    }
+
+    // Number of rows whose code is flagged in matches.
+    int countMatching(const vector<char> &matches) const
+    {
+        int total = 0;
+        for (size_t code = 0; code < postings.size() && code < matches.size(); ++code)
+        {
+            if (matches[code])
+                total += (int)postings[code].size();
+        }
+        return total;
+    }
+
+    // Calls visit on every row whose code is flagged in matches, in store
+    // order, until visit returns false. Only flagged posting lists are read;
+    // there are few codes, so the merge just picks the smallest head each step.
+    template <typename Visit>
+    void forEachMatching(const vector<char> &matches, Visit visit) const
+    {
+        vector<const vector<Posting> *> lists;
+        for (size_t code = 0; code < postings.size() && code < matches.size(); ++code)
+        {
+            if (matches[code] && !postings[code].empty())
+                lists.push_back(&postings[code]);
+        }
+        vector<size_t> heads(lists.size(), 0);
+
+        while (true)
+        {
+            int best = -1;
+            for (size_t l = 0; l < lists.size(); ++l)
+            {
+                if (heads[l] == lists[l]->size())
+                    continue;
+                if (best == -1 ||
+                    postingPosition((*lists[l])[heads[l]]) < postingPosition((*lists[best])[heads[best]]))
+                    best = (int)l;
+            }
+            if (best == -1 || !visit((*lists[best])[heads[best]++]))
+                return;
+        }
+    }
+
+    size_t bytes() const
+    {
+        size_t total = postings.capacity() * sizeof(vector<Posting>);
+        for (const auto &list : postings)
+            total += list.capacity() * sizeof(Posting);
+        return total;
+    }
+
+    void clear() { postings.clear(); }
+};
+
+#endif
@@ -1,154 +1,122 @@
 #include <iostream>
 #include <fstream>
-#include <sstream>
 #include <iomanip>
 #include <algorithm>
+#include <string_view>
 #include <cctype>
 #include <cstdlib>
 #include <ctime>
 #include "Transaction.hpp"
 #include "ArrayTransactionStore.hpp"
 #include "LinkedListTransactionStore.hpp"
+#include "ColumnarTransactionStore.hpp"
+#include "MappedFile.hpp"
+#include "CsvFieldSplitter.hpp"
+#include "TransactionSnapshot.hpp"
+#include "ResultCursor.hpp"
+#include "ParallelSort.hpp"
+#include "TransactionExporter.hpp"
+#include "MemoryUsage.hpp"
+#include "FraudAnalytics.hpp"
+#include "SyntheticDataGenerator.hpp"
 #include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <filesystem>
+#include <unordered_map>
+#include <random>
+#include <climits>
 
 using namespace std;
 using namespace std::chrono;
 
 ArrayTransactionStore cardStore, achStore, upiStore, wireStore;
 LinkedListTransactionStore cardLL, achLL, upiLL, wireLL;
+ColumnarTransactionStore cardColumns, achColumns, upiColumns, wireColumns;
 
-// Backup stores for original unsorted data
-ArrayTransactionStore cardStoreOriginal, achStoreOriginal, upiStoreOriginal, wireStoreOriginal;
-LinkedListTransactionStore cardLLOriginal, achLLOriginal, upiLLOriginal, wireLLOriginal;
-
-#define MAX_TRANSACTIONS 500000
 bool isLinkedMode = false;
-
-#define WIN32_LEAN_AND_MEAN
-#ifndef NOMINMAX
-#define NOMINMAX
-#endif
-#include <windows.h>
-#include <psapi.h>
+bool isColumnarMode = false;
 
 // ------------------ Utility Functions ----------------------
-void exportStoreToJSON(const string &filename, const ArrayTransactionStore &store)
+// Writes the four channel stores to <prefix>_<channel><extension>, one
+// thread per file; the stores are only read.
+template <typename Store>
+void exportChannels(const string &prefix, Store *const (&stores)[4], ExportFormat format)
 {
-    ofstream out(filename);
-    if (!out.is_open())
+    const char *channels[] = {"card", "ach", "upi", "wire"};
+    string filenames[4];
+    bool written[4] = {};
+
+    auto start = high_resolution_clock::now();
+    vector<thread> writers;
+    for (int c = 0; c < 4; ++c)
     {
-        cerr << "Failed to open file for JSON export.\n";
-        return;
+        filenames[c] = prefix + "_" + channels[c] + exportFileExtension(format);
+        writers.emplace_back([&, c]()
+                             { written[c] = exportStore(filenames[c], *stores[c], format); });
     }
+    for (thread &writer : writers)
+        writer.join();
+    auto duration = duration_cast<milliseconds>(high_resolution_clock::now() - start);
 
-    out << "[\n";
-    for (int i = 0; i < store.size(); ++i)
+    for (int c = 0; c < 4; ++c)
     {
-        const Transaction &t = store.get(i);
-        out << "  {\n"
-            << "    \"transaction_id\": \"" << t.transaction_id << "\",\n"
-            << "    \"timestamp\": \"" << t.timestamp << "\",\n"
-            << "    \"sender_account\": \"" << t.sender_account << "\",\n"
-            << "    \"receiver_account\": \"" << t.receiver_account << "\",\n"
-            << "    \"amount\": " << t.amount << ",\n"
-            << "    \"transaction_type\": \"" << t.transaction_type << "\",\n"
-            << "    \"merchant_category\": \"" << t.merchant_category << "\",\n"
-            << "    \"location\": \"" << t.location << "\",\n"
-            << "    \"device_used\": \"" << t.device_used << "\",\n"
-            << "    \"is_fraud\": " << (t.is_fraud ? "true" : "false") << ",\n"
-            << "    \"fraud_type\": \"" << t.fraud_type << "\",\n"
-            << "    \"time_since_last_transaction\": \"" << t.time_since_last_transaction << "\",\n"
-            << "    \"spending_deviation_score\": \"" << t.spending_deviation_score << "\",\n"
-            << "    \"velocity_score\": " << t.velocity_score << ",\n"
-            << "    \"geo_anomaly_score\": " << t.geo_anomaly_score << ",\n"
-            << "    \"payment_channel\": \"" << t.payment_channel << "\",\n"
-            << "    \"ip_address\": \"" << t.ip_address << "\",\n"
-            << "    \"device_hash\": \"" << t.device_hash << "\"\n"
-            << "  }" << (i < store.size() - 1 ? "," : "") << "\n";
-    }
-    out << "]\n";
-
-    out.close();
-    cout << "Exported to " << filename << "\n";
-}
-
-void exportLinkedListToJSON(const string &filename, const LinkedListTransactionStore &store)
-{
-    ofstream out(filename);
-    if (!out.is_open())
-    {
-        cerr << "Failed to open file for JSON export.\n";
-        return;
+        if (written[c])
+            cout << "Exported to " << filenames[c] << "\n";
+        else
+            cerr << "Failed to write " << filenames[c] << " for " << exportFormatName(format) << " export.\n";
     }
+    cout << "Export time: " << duration.count() << " ms\n";
+}
 
-    out << "[\n";
-    ListNode *curr = store.getHead();
-    int index = 0;
-    int total = store.size();
-
-    while (curr)
-    {
-        const Transaction &t = curr->data;
-        out << "  {\n"
-            << "    \"transaction_id\": \"" << t.transaction_id << "\",\n"
-            << "    \"timestamp\": \"" << t.timestamp << "\",\n"
-            << "    \"sender_account\": \"" << t.sender_account << "\",\n"
-            << "    \"receiver_account\": \"" << t.receiver_account << "\",\n"
-            << "    \"amount\": " << t.amount << ",\n"
-            << "    \"transaction_type\": \"" << t.transaction_type << "\",\n"
-            << "    \"merchant_category\": \"" << t.merchant_category << "\",\n"
-            << "    \"location\": \"" << t.location << "\",\n"
-            << "    \"device_used\": \"" << t.device_used << "\",\n"
-            << "    \"is_fraud\": " << (t.is_fraud ? "true" : "false") << ",\n"
-            << "    \"fraud_type\": \"" << t.fraud_type << "\",\n"
-            << "    \"time_since_last_transaction\": \"" << t.time_since_last_transaction << "\",\n"
-            << "    \"spending_deviation_score\": \"" << t.spending_deviation_score << "\",\n"
-            << "    \"velocity_score\": " << t.velocity_score << ",\n"
-            << "    \"geo_anomaly_score\": " << t.geo_anomaly_score << ",\n"
-            << "    \"payment_channel\": \"" << t.payment_channel << "\",\n"
-            << "    \"ip_address\": \"" << t.ip_address << "\",\n"
-            << "    \"device_hash\": \"" << t.device_hash << "\"\n"
-            << "  }" << (index < total - 1 ? "," : "") << "\n";
-
-        curr = curr->next;
-        index++;
-    }
-
-    out << "]\n";
-    out.close();
-    cout << "Exported to " << filename << "\n";
+// Exact heap footprint of each channel store of the active mode, then what
+// each store's own allocator hook counted: its buffer, slabs or columns.
+template <typename Store>
+void printStoreFootprints(const char *label, Store *const (&stores)[4])
+{
+    const char *channels[] = {"card", "ach", "upi", "wire"};
+    size_t bytes[4], total = 0;
+    long long live = 0, peak = 0;
+    for (int c = 0; c < 4; ++c)
+    {
+        bytes[c] = stores[c]->footprintBytes();
+        total += bytes[c];
+        live += stores[c]->getAllocations().liveBytes();
+        peak += stores[c]->getAllocations().peakBytes();
+    }
+    cout << "[" << label << "] Space Usage: " << total << " bytes (";
+    for (int c = 0; c < 4; ++c)
+        cout << channels[c] << " " << bytes[c] << (c < 3 ? ", " : ")\n");
+    cout << fixed << setprecision(2) << "[HEAP] Store Allocations: " << live / (1024.0 * 1024.0) << " MB live, "
+         << peak / (1024.0 * 1024.0) << " MB peak (";
+    for (int c = 0; c < 4; ++c)
+        cout << channels[c] << " " << stores[c]->getAllocations().liveBytes() / (1024.0 * 1024.0) << (c < 3 ? ", " : " MB)\n");
 }
 
 void printSpaceUsage()
 {
-    if (!isLinkedMode)
+    if (isColumnarMode)
     {
-        size_t total1 =
-            cardStore.size() * sizeof(Transaction) +
-            achStore.size() * sizeof(Transaction) +
-            upiStore.size() * sizeof(Transaction) +
-            wireStore.size() * sizeof(Transaction);
-        cout << "[ARRAY] Estimated Space Usage: " << total1 << " bytes\n";
+        ColumnarTransactionStore *const stores[] = {&cardColumns, &achColumns, &upiColumns, &wireColumns};
+        printStoreFootprints("COLUMNAR", stores);
+    }
+    else if (!isLinkedMode)
+    {
+        ArrayTransactionStore *const stores[] = {&cardStore, &achStore, &upiStore, &wireStore};
+        printStoreFootprints("ARRAY", stores);
     }
     else
     {
-        size_t total2 =
-            cardLL.size() * (sizeof(Transaction) + sizeof(ListNode *)) +
-            achLL.size() * (sizeof(Transaction) + sizeof(ListNode *)) +
-            upiLL.size() * (sizeof(Transaction) + sizeof(ListNode *)) +
-            wireLL.size() * (sizeof(Transaction) + sizeof(ListNode *));
-        cout << "[LINKED LIST] Estimated Space Usage: " << total2 << " bytes\n";
+        LinkedListTransactionStore *const stores[] = {&cardLL, &achLL, &upiLL, &wireLL};
+        printStoreFootprints("LINKED LIST", stores);
     }
 }
 
 double getRSSMemoryUsage()
 {
-    PROCESS_MEMORY_COUNTERS pmc;
-    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
-    {
-        return pmc.WorkingSetSize / (1024.0 * 1024.0);
-    }
-    return 0.0;
+    return readProcessMemory().rssMB;
 }
 
 void printMemoryUsageComparison(double rssBefore, double rssAfter)
@@ -160,17 +128,18 @@ void printMemoryUsageComparison(double rssBefore, double rssAfter)
         cout << "[RSS] Memory Usage: " << (rssAfter - rssBefore) << " MB\n";
     else
         cout << "[RSS] Memory Usage: " << (rssBefore - rssAfter) << " MB\n";
+    cout << "[RSS] Peak RSS: " << readProcessMemory().peakRssMB << " MB\n";
 }
 
 void printTransaction(const Transaction &t)
 {
     cout << fixed << setprecision(2);
     cout << "ID: " << t.transaction_id
-         << " | Location: " << t.location
+         << " | Location: " << fieldDictionaries.location.decode(t.location)
          << " | Amount: " << t.amount
-         << " | Type: " << t.transaction_type
+         << " | Type: " << fieldDictionaries.transactionType.decode(t.transaction_type)
          << " | Fraud: " << (t.is_fraud ? "YES" : "NO")
-         << " | Channel: " << t.payment_channel
+         << " | Channel: " << fieldDictionaries.paymentChannel.decode(t.payment_channel)
          << endl;
 }
 
@@ -181,6 +150,17 @@ string toLower(const string &str)
     return result;
 }
 
+// Flags every transaction_type code whose value contains searchTermLower, so
+// matching a row becomes a single table lookup on its code.
+vector<char> matchingTransactionTypes(const string &searchTermLower)
+{
+    const StringDictionary &types = fieldDictionaries.transactionType;
+    vector<char> matches(types.size(), 0);
+    for (int code = 0; code < types.size(); ++code)
+        matches[code] = toLower(types.decode(code)).find(searchTermLower) != string::npos;
+    return matches;
+}
+
 void paginateArrayResults(const string &title, const ArrayTransactionStore &store, bool &exitEarly)
 {
     int page = 0;
@@ -195,7 +175,7 @@ void paginateArrayResults(const string &title, const ArrayTransactionStore &stor
 
         for (int i = start; i < end; ++i)
         {
-            printTransaction(store.get(i));
+            printTransaction(store.getRef(store.rowAt(i)));
         }
 
         if (start >= store.size())
@@ -228,21 +208,15 @@ void paginateLinkedListResults(const string &title, const LinkedListTransactionS
     {
         cout << "\n--- " << title << " | Page " << (page + 1) << " ---\n";
         int start = page * pageSize;
-        int end = start + pageSize;
 
-        int index = 0;
+        // Jump to the page through the store's skip index, then walk it.
         int shown = 0;
-        ListNode *curr = store.getHead();
-
-        while (curr && index < end)
+        ListNode *curr = store.nodeAt(start);
+        while (curr && shown < pageSize)
         {
-            if (index >= start)
-            {
-                printTransaction(curr->data);
-                shown++;
-            }
+            printTransaction(curr->data);
+            shown++;
             curr = curr->next;
-            index++;
         }
 
         if (shown == 0)
@@ -263,8 +237,7 @@ void paginateLinkedListResults(const string &title, const LinkedListTransactionS
     } while (nav != 'b');
 }
 
-// Filtered pagination functions for array search results
-void paginateFilteredArrayResults(const string &title, const ArrayTransactionStore &store, const string &searchTermLower, bool &exitEarly, high_resolution_clock::time_point start, const string &searchType, double rssBefore, double rssAfter)
+void paginateColumnarResults(const string &title, const ColumnarTransactionStore &store, bool &exitEarly)
 {
     int page = 0;
     char nav;
@@ -273,30 +246,50 @@ void paginateFilteredArrayResults(const string &title, const ArrayTransactionSto
     do
     {
         cout << "\n--- " << title << " | Page " << (page + 1) << " ---\n";
-        int startIdx = page * pageSize;
-        int shown = 0;
-        int totalMatched = 0;
+        int start = page * pageSize;
+        int end = min(start + pageSize, store.size());
 
-        for (int i = 0; i < store.size(); ++i)
+        for (int i = start; i < end; ++i)
         {
-            string typeLower = toLower(store.get(i).transaction_type);
-            if (typeLower.find(searchTermLower) != string::npos)
-                totalMatched++;
+            printTransaction(store.get(store.rowAt(i)));
         }
 
-        int matchIndex = 0;
-        for (int i = 0; i < store.size() && shown < pageSize; ++i)
+        if (start >= store.size())
         {
-            string typeLower = toLower(store.get(i).transaction_type);
-            if (typeLower.find(searchTermLower) != string::npos)
-            {
-                if (matchIndex >= startIdx)
-                {
-                    printTransaction(store.get(i));
-                    shown++;
-                }
-                matchIndex++;
-            }
+            cout << "No more data.\n";
+        }
+
+        cout << "\n[N]ext Page | [P]revious Page | [B]ack (Payment Channel) | [E]xit to Main Menu: ";
+        cin >> nav;
+        nav = tolower(nav);
+        if (nav == 'n')
+            page++;
+        else if (nav == 'p' && page > 0)
+            page--;
+        else if (nav == 'e')
+        {
+            exitEarly = true;
+            return;
+        }
+    } while (nav != 'b');
+}
+
+// Filtered pagination functions for array search results
+void paginateFilteredResults(const string &title, const ArrayTransactionStore &store, const ResultCursor<int> &results, bool &exitEarly, long long searchMs, const string &searchType, double rssBefore, double rssAfter)
+{
+    int page = 0;
+    char nav = 0;
+    int totalMatched = results.size();
+
+    do
+    {
+        cout << "\n--- " << title << " | Page " << (page + 1) << " ---\n";
+        int shown = 0;
+
+        for (int i = results.pageBegin(page); i < results.pageEnd(page); ++i)
+        {
+            printTransaction(store.getRef(results.at(i)));
+            shown++;
         }
 
         if (shown == 0)
@@ -306,10 +299,8 @@ void paginateFilteredArrayResults(const string &title, const ArrayTransactionSto
 
         if (nav != 'n' && nav != 'p' && nav != 'b')
         {
-            auto end = high_resolution_clock::now();
-            auto duration = duration_cast<milliseconds>(end - start);
             cout << endl;
-            cout << "[INFO] " << searchType << " Search Time: " << duration.count() << " ms\n";
+            cout << "[INFO] " << searchType << " Search Time: " << searchMs << " ms\n";
             printSpaceUsage();
             printMemoryUsageComparison(rssBefore, rssAfter);
         }
@@ -330,43 +321,21 @@ void paginateFilteredArrayResults(const string &title, const ArrayTransactionSto
 }
 
 // Filtered pagination functions for linked list search results
-void paginateFilteredLinkedListResults(const string &title, const LinkedListTransactionStore &store, const string &searchTermLower, bool &exitEarly, high_resolution_clock::time_point start, const string &searchType, double rssBefore, double rssAfter)
+void paginateFilteredResults(const string &title, const LinkedListTransactionStore &, const ResultCursor<ListNode *> &results, bool &exitEarly, long long searchMs, const string &searchType, double rssBefore, double rssAfter)
 {
     int page = 0;
-    char nav;
-    const int pageSize = 5;
+    char nav = 0;
+    int totalMatched = results.size();
 
     do
     {
         cout << "\n--- " << title << " | Page " << (page + 1) << " ---\n";
-        int startIdx = page * pageSize;
         int shown = 0;
-        int totalMatched = 0;
-
-        ListNode *curr = store.getHead();
-        while (curr)
-        {
-            string typeLower = toLower(curr->data.transaction_type);
-            if (typeLower.find(searchTermLower) != string::npos)
-                totalMatched++;
-            curr = curr->next;
-        }
 
-        int matchIndex = 0;
-        curr = store.getHead();
-        while (curr && shown < pageSize)
+        for (int i = results.pageBegin(page); i < results.pageEnd(page); ++i)
         {
-            string typeLower = toLower(curr->data.transaction_type);
-            if (typeLower.find(searchTermLower) != string::npos)
-            {
-                if (matchIndex >= startIdx)
-                {
-                    printTransaction(curr->data);
-                    shown++;
-                }
-                matchIndex++;
-            }
-            curr = curr->next;
+            printTransaction(results.at(i)->data);
+            shown++;
         }
 
         if (shown == 0)
@@ -376,11 +345,8 @@ void paginateFilteredLinkedListResults(const string &title, const LinkedListTran
 
         if (nav != 'n' && nav != 'p' && nav != 'b')
         {
-            auto end = high_resolution_clock::now();
-            double rssAfter = getRSSMemoryUsage();
-            auto duration = duration_cast<milliseconds>(end - start);
             cout << endl;
-            cout << "[INFO] " << searchType << " Search Time: " << duration.count() << " ms\n";
+            cout << "[INFO] " << searchType << " Search Time: " << searchMs << " ms\n";
             printSpaceUsage();
             printMemoryUsageComparison(rssBefore, rssAfter);
         }
@@ -400,117 +366,329 @@ void paginateFilteredLinkedListResults(const string &title, const LinkedListTran
     } while (nav != 'b');
 }
 
-// ------------------ LOAD & PARSE ----------------------
-Transaction parseTransaction(const string &line)
+// Filtered pagination functions for columnar search results; full rows are
+// assembled only for the matches on the page.
+void paginateFilteredResults(const string &title, const ColumnarTransactionStore &store, const ResultCursor<int> &results, bool &exitEarly, long long searchMs, const string &searchType, double rssBefore, double rssAfter)
 {
-    stringstream ss(line);
-    string cell;
-    Transaction t;
+    int page = 0;
+    char nav = 0;
+    int totalMatched = results.size();
+
+    do
+    {
+        cout << "\n--- " << title << " | Page " << (page + 1) << " ---\n";
+        int shown = 0;
+
+        for (int i = results.pageBegin(page); i < results.pageEnd(page); ++i)
+        {
+            printTransaction(store.get(results.at(i)));
+            shown++;
+        }
 
-    getline(ss, t.transaction_id, ',');
-    if (t.transaction_id.empty())
-        t.transaction_id = "null";
+        if (shown == 0)
+            cout << "No more results.\n";
+        else
+            cout << "Showing " << shown << " results (Total matches: " << totalMatched << ")\n";
 
-    getline(ss, t.timestamp, ',');
-    if (t.timestamp.empty())
-        t.timestamp = "null";
+        if (nav != 'n' && nav != 'p' && nav != 'b')
+        {
+            cout << endl;
+            cout << "[INFO] " << searchType << " Search Time: " << searchMs << " ms\n";
+            printSpaceUsage();
+            printMemoryUsageComparison(rssBefore, rssAfter);
+        }
 
-    getline(ss, t.sender_account, ',');
-    if (t.sender_account.empty())
-        t.sender_account = "null";
+        cout << "\n[N]ext Page | [P]revious Page | [B]ack (Payment Channel) | [E]xit to Main Menu: ";
+        cin >> nav;
+        nav = tolower(nav);
+        if (nav == 'n')
+            page++;
+        else if (nav == 'p' && page > 0)
+            page--;
+        else if (nav == 'e')
+        {
+            exitEarly = true;
+            return;
+        }
+    } while (nav != 'b');
+}
 
-    getline(ss, t.receiver_account, ',');
-    if (t.receiver_account.empty())
-        t.receiver_account = "null";
+// ------------------ LOAD & PARSE ----------------------
+#define TRANSACTION_FIELD_COUNT 18
 
-    getline(ss, cell, ',');
-    t.amount = cell.empty() ? 0.0 : stod(cell);
+// Splits line at commas into views over the original buffer. Returns false
+// when the line has fewer than TRANSACTION_FIELD_COUNT fields. All commas
+// are located in one vectorized pass (see CsvFieldSplitter.hpp).
+bool splitTransactionFields(string_view line, string_view *fields, CommaFinder finder = bestCommaFinder())
+{
+    size_t commas[TRANSACTION_FIELD_COUNT];
+    int found = finder(line.data(), line.size(), commas, TRANSACTION_FIELD_COUNT);
+    if (found < TRANSACTION_FIELD_COUNT - 1)
+        return false;
 
-    getline(ss, t.transaction_type, ',');
-    if (t.transaction_type.empty())
+    size_t pos = 0;
+    for (int f = 0; f < TRANSACTION_FIELD_COUNT - 1; ++f)
     {
-        t.transaction_type = "null";
+        fields[f] = line.substr(pos, commas[f] - pos);
+        pos = commas[f] + 1;
     }
-    else
+    // Like the old getline parser, anything after an 18th comma is ignored.
+    size_t end = (found == TRANSACTION_FIELD_COUNT) ? commas[TRANSACTION_FIELD_COUNT - 1] : line.size();
+    fields[TRANSACTION_FIELD_COUNT - 1] = line.substr(pos, end - pos);
+    return true;
+}
+
+string textField(string_view field)
+{
+    return field.empty() ? string("null") : string(field);
+}
+
+// Encodes field lower-cased; only builds a temporary when it has upper case.
+DictCode lowerDictionaryField(StringDictionary &dictionary, string_view field)
+{
+    if (field.empty())
+        return dictionary.encode("null");
+    for (char c : field)
     {
-        t.transaction_type = toLower(t.transaction_type);
+        if (isupper((unsigned char)c))
+            return dictionary.encode(toLower(string(field)));
     }
+    return dictionary.encode(field);
+}
+
+DictCode dictionaryField(StringDictionary &dictionary, string_view field)
+{
+    return dictionary.encode(field.empty() ? string_view("null") : field);
+}
+
+Transaction parseTransaction(const string_view *fields, TransactionDictionaries &dictionaries = fieldDictionaries)
+{
+    Transaction t;
 
-    getline(ss, t.merchant_category, ',');
-    if (t.merchant_category.empty())
-        t.merchant_category = "null";
+    t.transaction_id = textField(fields[0]);
+    t.timestamp = textField(fields[1]);
+    t.sender_account = textField(fields[2]);
+    t.receiver_account = textField(fields[3]);
+    t.amount = parseDoubleFast(fields[4]);
+    t.transaction_type = lowerDictionaryField(dictionaries.transactionType, fields[5]);
+    t.merchant_category = dictionaryField(dictionaries.merchantCategory, fields[6]);
+    t.location = dictionaryField(dictionaries.location, fields[7]);
+    t.device_used = dictionaryField(dictionaries.deviceUsed, fields[8]);
+
+    string_view fraud = fields[9];
+    t.is_fraud = fraud.size() == 4 &&
+                 tolower(fraud[0]) == 't' && tolower(fraud[1]) == 'r' &&
+                 tolower(fraud[2]) == 'u' && tolower(fraud[3]) == 'e';
+
+    t.fraud_type = dictionaryField(dictionaries.fraudType, fields[10]);
+    t.time_since_last_transaction = textField(fields[11]);
+    t.spending_deviation_score = textField(fields[12]);
+    t.velocity_score = parseDoubleFast(fields[13]);
+    t.geo_anomaly_score = parseDoubleFast(fields[14]);
+    t.payment_channel = lowerDictionaryField(dictionaries.paymentChannel, fields[15]);
+    t.ip_address = textField(fields[16]);
+    t.device_hash = textField(fields[17]);
 
-    getline(ss, t.location, ',');
-    if (t.location.empty())
-        t.location = "null";
+    return t;
+}
 
-    getline(ss, t.device_used, ',');
-    if (t.device_used.empty())
-        t.device_used = "null";
+// ------------------ PARALLEL INGESTION ----------------------
+// Rows parsed from one newline-aligned slice of the file. Every chunk encodes
+// into its own dictionaries so workers share no mutable state; the codes are
+// remapped onto fieldDictionaries when the chunk is merged.
+struct ParsedChunk
+{
+    TransactionDictionaries dictionaries;
+    vector<Transaction> rows;
+};
+
+// Translates one chunk's dictionary codes into fieldDictionaries codes.
+// Building it encodes the chunk's values in first-seen order, so merging
+// chunks in file order hands out the same codes the serial loader did.
+struct DictionaryRemap
+{
+    vector<DictCode> transactionType, merchantCategory, location, deviceUsed, fraudType, paymentChannel;
 
-    getline(ss, cell, ',');
-    if (cell.empty())
+    static vector<DictCode> build(const StringDictionary &local, StringDictionary &global)
     {
-        t.is_fraud = false;
+        vector<DictCode> codes(local.size());
+        for (int code = 0; code < local.size(); ++code)
+            codes[code] = global.encode(local.decode(code));
+        return codes;
     }
-    else
+
+    DictionaryRemap(const TransactionDictionaries &local, TransactionDictionaries &global)
+        : transactionType(build(local.transactionType, global.transactionType)),
+          merchantCategory(build(local.merchantCategory, global.merchantCategory)),
+          location(build(local.location, global.location)),
+          deviceUsed(build(local.deviceUsed, global.deviceUsed)),
+          fraudType(build(local.fraudType, global.fraudType)),
+          paymentChannel(build(local.paymentChannel, global.paymentChannel))
     {
-        for (char &c : cell)
-            c = tolower(c);
-        t.is_fraud = (cell == "true");
     }
 
-    getline(ss, t.fraud_type, ',');
-    if (t.fraud_type.empty())
-        t.fraud_type = "null";
+    void apply(Transaction &t) const
+    {
+        t.transaction_type = transactionType[t.transaction_type];
+        t.merchant_category = merchantCategory[t.merchant_category];
+        t.location = location[t.location];
+        t.device_used = deviceUsed[t.device_used];
+        t.fraud_type = fraudType[t.fraud_type];
+        t.payment_channel = paymentChannel[t.payment_channel];
+    }
+};
 
-    getline(ss, t.time_since_last_transaction, ',');
-    if (t.time_since_last_transaction.empty())
-        t.time_since_last_transaction = "null";
+unsigned ingestThreadCount()
+{
+    unsigned threads = thread::hardware_concurrency();
+    return threads == 0 ? 1 : threads;
+}
 
-    getline(ss, t.spending_deviation_score, ',');
-    if (t.spending_deviation_score.empty())
-        t.spending_deviation_score = "null";
+// Cuts data into roughly chunkCount pieces, each ending just after a newline.
+vector<string_view> splitIntoChunks(string_view data, size_t chunkCount)
+{
+    vector<string_view> chunks;
+    size_t target = max<size_t>(data.size() / max<size_t>(chunkCount, 1), 1);
+    size_t begin = 0;
+    while (begin < data.size())
+    {
+        size_t end = begin + target;
+        if (end >= data.size())
+        {
+            end = data.size();
+        }
+        else
+        {
+            size_t eol = data.find('\n', end - 1);
+            end = (eol == string_view::npos) ? data.size() : eol + 1;
+        }
+        chunks.push_back(data.substr(begin, end - begin));
+        begin = end;
+    }
+    return chunks;
+}
 
-    getline(ss, cell, ',');
-    t.velocity_score = cell.empty() ? 0.0 : stod(cell);
+void parseChunk(string_view chunk, ParsedChunk &result)
+{
+    string_view fields[TRANSACTION_FIELD_COUNT];
+    size_t pos = 0;
+    while (pos < chunk.size())
+    {
+        size_t eol = chunk.find('\n', pos);
+        if (eol == string_view::npos)
+            eol = chunk.size();
+        string_view line = chunk.substr(pos, eol - pos);
+        pos = eol + 1;
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+
+        if (line.empty() || !splitTransactionFields(line, fields))
+            continue;
 
-    getline(ss, cell, ',');
-    t.geo_anomaly_score = cell.empty() ? 0.0 : stod(cell);
+        // Rows without a payment channel are dropped, so skip parsing them.
+        if (fields[15].empty())
+            continue;
 
-    getline(ss, t.payment_channel, ',');
-    if (t.payment_channel.empty())
-    {
-        t.payment_channel = "null";
+        result.rows.push_back(parseTransaction(fields, result.dictionaries));
     }
-    else
+}
+
+// Runs work(c) for every chunk on a pool of worker threads. merge(c) runs on
+// the calling thread strictly in chunk order as soon as chunk c is done,
+// overlapping the merge with work on later chunks; returning false stops the
+// remaining work. Workers stay at most a few chunks ahead of the merge, so
+// only those chunks' rows are held at once.
+template <typename WorkFn, typename MergeFn>
+void processChunksInParallel(size_t chunkCount, WorkFn work, MergeFn merge)
+{
+    size_t workerCount = min<size_t>(chunkCount, ingestThreadCount());
+    size_t window = workerCount * 4;
+    atomic<size_t> nextChunk(0);
+    atomic<bool> stop(false);
+    size_t merged = 0;
+    mutex readyMutex;
+    condition_variable readyCondition;
+    vector<char> ready(chunkCount, 0);
+
+    vector<thread> workers;
+    for (size_t w = 0; w < workerCount; ++w)
     {
-        t.payment_channel = toLower(t.payment_channel);
+        workers.emplace_back([&]()
+                             {
+            while (!stop)
+            {
+                size_t c = nextChunk++;
+                if (c >= chunkCount)
+                    break;
+                {
+                    unique_lock<mutex> lock(readyMutex);
+                    readyCondition.wait(lock, [&]()
+                                        { return stop || c < merged + window; });
+                }
+                if (stop)
+                    break;
+                work(c);
+                {
+                    lock_guard<mutex> lock(readyMutex);
+                    ready[c] = 1;
+                }
+                readyCondition.notify_all();
+            } });
     }
 
-    getline(ss, t.ip_address, ',');
-    if (t.ip_address.empty())
-        t.ip_address = "null";
+    for (size_t c = 0; c < chunkCount; ++c)
+    {
+        {
+            unique_lock<mutex> lock(readyMutex);
+            readyCondition.wait(lock, [&]()
+                                { return ready[c] != 0; });
+        }
+        bool keepGoing = merge(c);
+        {
+            lock_guard<mutex> lock(readyMutex);
+            merged = c + 1;
+            stop = stop || !keepGoing;
+        }
+        readyCondition.notify_all();
+        if (!keepGoing)
+            break;
+    }
 
-    getline(ss, t.device_hash, ',');
-    if (t.device_hash.empty())
-        t.device_hash = "null";
+    for (thread &worker : workers)
+        worker.join();
+}
 
-    return t;
+// Parses every chunk in parallel into parsed, merging in chunk order.
+template <typename MergeFn>
+void parseChunksInParallel(const vector<string_view> &chunks, vector<ParsedChunk> &parsed, MergeFn merge)
+{
+    processChunksInParallel(chunks.size(), [&](size_t c)
+                            { parseChunk(chunks[c], parsed[c]); }, merge);
 }
 
-void loadData(const string &filename)
+// Appends t to the store of a channel (0 = card, 1 = ach, 2 = upi,
+// 3 = wire) for the active mode.
+void addToChannel(int channel, Transaction &&t)
 {
-    ifstream file(filename);
-    if (!file.is_open())
+    if (isColumnarMode)
     {
-        cerr << "Error opening file.\n";
-        return;
+        ColumnarTransactionStore *stores[] = {&cardColumns, &achColumns, &upiColumns, &wireColumns};
+        stores[channel]->add(std::move(t));
     }
+    else if (isLinkedMode)
+    {
+        LinkedListTransactionStore *stores[] = {&cardLL, &achLL, &upiLL, &wireLL};
+        stores[channel]->add(std::move(t));
+    }
+    else
+    {
+        ArrayTransactionStore *stores[] = {&cardStore, &achStore, &upiStore, &wireStore};
+        stores[channel]->add(std::move(t));
+    }
+}
 
-    string line;
-    getline(file, line);
-
+void clearAllStores()
+{
     cardStore.clear();
     achStore.clear();
     upiStore.clear();
@@ -519,93 +697,48 @@ void loadData(const string &filename)
     achLL.clear();
     upiLL.clear();
     wireLL.clear();
+    cardColumns.clear();
+    achColumns.clear();
+    upiColumns.clear();
+    wireColumns.clear();
+}
 
-    // Clear backup stores
-    cardStoreOriginal.clear();
-    achStoreOriginal.clear();
-    upiStoreOriginal.clear();
-    wireStoreOriginal.clear();
-    cardLLOriginal.clear();
-    achLLOriginal.clear();
-    upiLLOriginal.clear();
-    wireLLOriginal.clear();
-
-    int totalTransactionsLoaded = 0;
-
-    while (getline(file, line) && totalTransactionsLoaded < MAX_TRANSACTIONS)
+// Builds the transaction_type index of every store in the current mode up
+// front, so the first search does not pay for it. The index follows
+// insertion order, so sorting never invalidates it.
+void rebuildTypeIndexes()
+{
+    if (isColumnarMode)
     {
-        if (line.empty() || count(line.begin(), line.end(), ',') < 17)
-            continue;
-
-        Transaction t = parseTransaction(line);
-
-        const string &channel = t.payment_channel;
-
-        if (channel == "null")
-        {
-            continue;
-        }
-
-        if (isLinkedMode)
-        {
-            if (channel == "card")
-            {
-                cardLL.add(t);
-                cardLLOriginal.add(t);
-                totalTransactionsLoaded++;
-            }
-            else if (channel == "ach")
-            {
-                achLL.add(t);
-                achLLOriginal.add(t);
-                totalTransactionsLoaded++;
-            }
-            else if (channel == "upi")
-            {
-                upiLL.add(t);
-                upiLLOriginal.add(t);
-                totalTransactionsLoaded++;
-            }
-            else if (channel == "wire_transfer")
-            {
-                wireLL.add(t);
-                wireLLOriginal.add(t);
-                totalTransactionsLoaded++;
-            }
-        }
-        else
-        {
-            if (channel == "card")
-            {
-                cardStore.add(t);
-                cardStoreOriginal.add(t);
-                totalTransactionsLoaded++;
-            }
-            else if (channel == "ach")
-            {
-                achStore.add(t);
-                achStoreOriginal.add(t);
-                totalTransactionsLoaded++;
-            }
-            else if (channel == "upi")
-            {
-                upiStore.add(t);
-                upiStoreOriginal.add(t);
-                totalTransactionsLoaded++;
-            }
-            else if (channel == "wire_transfer")
-            {
-                wireStore.add(t);
-                wireStoreOriginal.add(t);
-                totalTransactionsLoaded++;
-            }
-        }
+        ColumnarTransactionStore *stores[] = {&cardColumns, &achColumns, &upiColumns, &wireColumns};
+        for (ColumnarTransactionStore *store : stores)
+            store->rebuildTypeIndex();
     }
+    else if (!isLinkedMode)
+    {
+        ArrayTransactionStore *stores[] = {&cardStore, &achStore, &upiStore, &wireStore};
+        for (ArrayTransactionStore *store : stores)
+            store->rebuildTypeIndex();
+    }
+    else
+    {
+        LinkedListTransactionStore *stores[] = {&cardLL, &achLL, &upiLL, &wireLL};
+        for (LinkedListTransactionStore *store : stores)
+            store->rebuildTypeIndex();
+    }
+}
 
-    file.close();
-
+void printLoadSummary(int totalTransactionsLoaded)
+{
     cout << "\nLoaded Transactions (Total: " << totalTransactionsLoaded << "):\n";
-    if (isLinkedMode)
+    if (isColumnarMode)
+    {
+        cout << "Card: " << cardColumns.size()
+             << " | ACH: " << achColumns.size()
+             << " | UPI: " << upiColumns.size()
+             << " | Wire Transfer: " << wireColumns.size() << endl;
+    }
+    else if (isLinkedMode)
     {
         cout << "Card: " << cardLL.size()
              << " | ACH: " << achLL.size()
@@ -621,189 +754,424 @@ void loadData(const string &filename)
     }
 }
 
-// ---------------- LINEAR SEARCH FOR ARRAY & LINKED LIST----------------
-void linearSearchByTransactionType(const string &searchTermLower, double rssBefore)
+// ------------------ SNAPSHOT ----------------------
+// Size and modification time identify the CSV a snapshot was built from.
+bool sourceFileStamp(const string &filename, uint64_t &size, int64_t &modified)
 {
-    auto start = high_resolution_clock::now();
-    bool found = false;
-    if (!isLinkedMode)
+    error_code ec;
+    uintmax_t fileSize = filesystem::file_size(filename, ec);
+    if (ec)
+        return false;
+    filesystem::file_time_type writeTime = filesystem::last_write_time(filename, ec);
+    if (ec)
+        return false;
+    size = fileSize;
+    modified = (int64_t)writeTime.time_since_epoch().count();
+    return true;
+}
+
+// Writes the stores in insertion (file) order, whatever view is active.
+void saveSnapshot(const string &snapshotPath, uint64_t sourceSize, int64_t sourceModified)
+{
+    SnapshotWriter writer;
+    for (int c = 0; c < SNAPSHOT_CHANNELS; ++c)
     {
-        ArrayTransactionStore *stores[] = {&cardStoreOriginal, &achStoreOriginal, &upiStoreOriginal, &wireStoreOriginal};
-        for (int s = 0; s < 4 && !found; ++s)
+        writer.beginChannel(c);
+        if (isColumnarMode)
         {
-            for (int i = 0; i < stores[s]->size(); ++i)
-            {
-                if (toLower(stores[s]->get(i).transaction_type).find(searchTermLower) != string::npos)
-                {
-                    found = true;
-                    break;
-                }
-            }
+            const ColumnarTransactionStore *stores[] = {&cardColumns, &achColumns, &upiColumns, &wireColumns};
+            for (int i = 0; i < stores[c]->size(); ++i)
+                writer.addRow(stores[c]->get(i));
         }
-    }
-    else
-    {
-        LinkedListTransactionStore *stores[] = {&cardLLOriginal, &achLLOriginal, &upiLLOriginal, &wireLLOriginal};
-        for (int s = 0; s < 4 && !found; ++s)
+        else if (isLinkedMode)
         {
-            ListNode *curr = stores[s]->getHead();
-            while (curr && !found)
-            {
-                if (toLower(curr->data.transaction_type).find(searchTermLower) != string::npos)
-                {
-                    found = true;
-                    break;
-                }
-                curr = curr->next;
-            }
+            const LinkedListTransactionStore *stores[] = {&cardLL, &achLL, &upiLL, &wireLL};
+            stores[c]->forEachInserted([&](const ListNode *node)
+                                       { writer.addRow(node->data); });
+        }
+        else
+        {
+            const ArrayTransactionStore *stores[] = {&cardStore, &achStore, &upiStore, &wireStore};
+            for (int i = 0; i < stores[c]->size(); ++i)
+                writer.addRow(stores[c]->getRef(i));
         }
     }
 
-    if (found)
-    {
-        bool exitEarly = false;
-        if (!isLinkedMode)
+    if (!writer.save(snapshotPath, fieldDictionaries, sourceSize, sourceModified))
+        cerr << "[WARN] Could not write snapshot " << snapshotPath << "\n";
+}
+
+// Fills the stores from a snapshot; returns false (touching nothing) when the
+// snapshot is missing, corrupt or stale so the caller falls back to the CSV.
+bool loadSnapshot(const string &snapshotPath, uint64_t sourceSize, int64_t sourceModified, int &totalTransactionsLoaded)
+{
+    SnapshotReader reader;
+    if (!reader.open(snapshotPath, sourceSize, sourceModified))
+        return false;
+
+    reader.restoreDictionaries(fieldDictionaries);
+    for (int c = 0; c < SNAPSHOT_CHANNELS; ++c)
+    {
+        int rows = (int)(reader.channelEnd(c) - reader.channelBegin(c));
+        if (isColumnarMode)
         {
-            ArrayTransactionStore *stores[] = {&cardStoreOriginal, &achStoreOriginal, &upiStoreOriginal, &wireStoreOriginal};
-            string storeNames[] = {"Card Transactions", "ACH Transactions", "UPI Transactions", "Wire Transactions"};
-            for (int i = 0; i < 4 && !exitEarly; ++i)
-            {
-                bool hasMatches = false;
-                for (int j = 0; j < stores[i]->size(); ++j)
-                {
-                    if (toLower(stores[i]->get(j).transaction_type).find(searchTermLower) != string::npos)
-                    {
-                        hasMatches = true;
-                        break;
-                    }
-                }
-                if (hasMatches)
-                {
-                    double rssAfter = getRSSMemoryUsage();
-                    paginateFilteredArrayResults(storeNames[i], *stores[i], searchTermLower, exitEarly, start, "Linear", rssBefore, rssAfter);
-                }
-            }
+            ColumnarTransactionStore *stores[] = {&cardColumns, &achColumns, &upiColumns, &wireColumns};
+            stores[c]->reserve(rows);
         }
-        else
+        else if (!isLinkedMode)
         {
-            LinkedListTransactionStore *stores[] = {&cardLLOriginal, &achLLOriginal, &upiLLOriginal, &wireLLOriginal};
-            string storeNames[] = {"Card Transactions", "ACH Transactions", "UPI Transactions", "Wire Transactions"};
-            for (int i = 0; i < 4 && !exitEarly; ++i)
-            {
-                bool hasMatches = false;
-                ListNode *curr = stores[i]->getHead();
-                while (curr && !hasMatches)
-                {
-                    if (toLower(curr->data.transaction_type).find(searchTermLower) != string::npos)
-                    {
-                        hasMatches = true;
-                        break;
-                    }
-                    curr = curr->next;
-                }
-                if (hasMatches)
-                {
-                    double rssAfter = getRSSMemoryUsage();
-                    paginateFilteredLinkedListResults(storeNames[i], *stores[i], searchTermLower, exitEarly, start, "Linear", rssBefore, rssAfter);
-                }
-            }
+            ArrayTransactionStore *stores[] = {&cardStore, &achStore, &upiStore, &wireStore};
+            stores[c]->reserve(rows);
         }
+        for (uint64_t i = reader.channelBegin(c); i < reader.channelEnd(c); ++i)
+            addToChannel(c, reader.row(i));
+    }
+    totalTransactionsLoaded = (int)reader.rowCount();
+    return true;
+}
+
+// Encodes the four loaded payment channels (card, ach, upi, wire) before any
+// row, so they get the same codes whatever the data holds.
+void encodeChannelCodes(DictCode (&codes)[4])
+{
+    const char *channels[] = {"card", "ach", "upi", "wire_transfer"};
+    for (int c = 0; c < 4; ++c)
+        codes[c] = fieldDictionaries.paymentChannel.encode(channels[c]);
+}
+
+// Remaps a parsed chunk onto fieldDictionaries and moves its rows into the
+// channel stores, releasing the chunk's rows. Returns the number kept.
+int mergeParsedChunk(ParsedChunk &chunk, const DictCode (&channelCodes)[4])
+{
+    int kept = 0;
+    DictionaryRemap remap(chunk.dictionaries, fieldDictionaries);
+    for (Transaction &t : chunk.rows)
+    {
+        remap.apply(t);
+
+        // Rows on any other channel (including "null") are dropped.
+        int channelIndex = 0;
+        while (channelIndex < 4 && t.payment_channel != channelCodes[channelIndex])
+            ++channelIndex;
+        if (channelIndex == 4)
+            continue;
+
+        addToChannel(channelIndex, std::move(t));
+        kept++;
+    }
+    vector<Transaction>().swap(chunk.rows);
+    return kept;
+}
+
+// Growth is geometric; give the unused tail back once loading is done, then
+// index and summarize the stores.
+void finishLoad(int totalTransactionsLoaded)
+{
+    ArrayTransactionStore *arrayStores[] = {&cardStore, &achStore, &upiStore, &wireStore};
+    for (ArrayTransactionStore *store : arrayStores)
+        store->shrinkToFit();
+    rebuildTypeIndexes();
+
+    printLoadSummary(totalTransactionsLoaded);
+}
+
+// Loads filename through the snapshot at snapshotPath when it is current,
+// otherwise parses the CSV and writes the snapshot. An empty snapshotPath
+// parses the CSV and leaves any snapshot alone.
+void loadData(const string &filename, const string &snapshotPath)
+{
+    clearAllStores();
+    // Every store was emptied above, so the old codes are no longer referenced.
+    fieldDictionaries.clear();
+
+    int totalTransactionsLoaded = 0;
+
+    uint64_t sourceSize = 0;
+    int64_t sourceModified = 0;
+    bool stamped = !snapshotPath.empty() && sourceFileStamp(filename, sourceSize, sourceModified);
+    if (stamped && loadSnapshot(snapshotPath, sourceSize, sourceModified, totalTransactionsLoaded))
+    {
+        rebuildTypeIndexes();
+        cout << "\n[INFO] Loaded from snapshot " << snapshotPath << "\n";
+        printLoadSummary(totalTransactionsLoaded);
+        return;
+    }
+
+    MappedFile file;
+    if (!file.open(filename))
+    {
+        cerr << "Error opening file.\n";
+        return;
+    }
+
+    // Fields are parsed straight out of the mapping; only the values the
+    // stores keep are copied.
+    string_view data = file.view();
+    size_t pos = data.find('\n');
+    pos = (pos == string_view::npos) ? data.size() : pos + 1;
+
+    DictCode channelCodes[4];
+    encodeChannelCodes(channelCodes);
+
+    // Aim for a few chunks per worker so uneven chunks still balance out, but
+    // keep chunks large enough that small files are not split needlessly.
+    string_view rows = data.substr(pos);
+    size_t chunkCount = min<size_t>(ingestThreadCount() * 4, rows.size() / (1 << 20) + 1);
+    vector<string_view> chunks = splitIntoChunks(rows, chunkCount);
+    vector<ParsedChunk> parsed(chunks.size());
+
+    parseChunksInParallel(chunks, parsed, [&](size_t c)
+                          {
+        totalTransactionsLoaded += mergeParsedChunk(parsed[c], channelCodes);
+        return true; });
+
+    file.close();
+    finishLoad(totalTransactionsLoaded);
+
+    if (stamped)
+        saveSnapshot(snapshotPath, sourceSize, sourceModified);
+}
+
+void loadData(const string &filename) { loadData(filename, filename + ".snapshot"); }
+
+// Streams generated rows straight into the stores: every worker renders a
+// block of CSV text and parses it as loadData would a chunk of the file, so
+// nothing is written to disk. No snapshot is kept.
+void loadSyntheticData(const SyntheticDataGenerator &generator)
+{
+    clearAllStores();
+    fieldDictionaries.clear();
+
+    DictCode channelCodes[4];
+    encodeChannelCodes(channelCodes);
+
+    int totalTransactionsLoaded = 0;
+    vector<ParsedChunk> parsed((size_t)generator.blockCount());
+    processChunksInParallel(parsed.size(), [&](size_t block)
+                            {
+        string text;
+        generator.appendBlock((long long)block, text);
+        parseChunk(text, parsed[block]); },
+                            [&](size_t block)
+                            {
+        totalTransactionsLoaded += mergeParsedChunk(parsed[block], channelCodes);
+        parsed[block] = ParsedChunk();
+        return true; });
+
+    finishLoad(totalTransactionsLoaded);
+}
+
+// Calls visit with the four channel stores of the active mode, so mode-
+// independent code can be written once as a generic lambda.
+template <typename Visit>
+void visitChannelStores(Visit visit)
+{
+    if (isColumnarMode)
+    {
+        ColumnarTransactionStore *const stores[] = {&cardColumns, &achColumns, &upiColumns, &wireColumns};
+        visit(stores);
+    }
+    else if (!isLinkedMode)
+    {
+        ArrayTransactionStore *const stores[] = {&cardStore, &achStore, &upiStore, &wireStore};
+        visit(stores);
     }
     else
     {
-        cout << "No results found.\n";
+        LinkedListTransactionStore *const stores[] = {&cardLL, &achLL, &upiLL, &wireLL};
+        visit(stores);
     }
 }
 
-// ---------------- BINARY SEARCH FOR ARRAY & LINKED LIST ----------------
-void BinarySearchByTransactionType(const string &searchTermLower, double rssBefore)
+// Result set type of a store: row positions, or nodes for a linked list.
+template <typename Store>
+using CursorFor = ResultCursor<conditional_t<is_same_v<Store, LinkedListTransactionStore>, ListNode *, int>>;
+
+// Shows each store's results in turn. The search itself finished before
+// this is called, so searchMs never includes time spent reading pages.
+template <typename Store>
+void paginateSearchResults(Store *const (&stores)[4], const CursorFor<Store> (&results)[4], long long searchMs, const string &searchType, double rssBefore)
 {
-    auto start = high_resolution_clock::now();
-    bool found = false;
+    string storeNames[] = {"Card Transactions", "ACH Transactions", "UPI Transactions", "Wire Transactions"};
+    double rssAfter = getRSSMemoryUsage();
     bool exitEarly = false;
-    if (!isLinkedMode)
+    for (int i = 0; i < 4 && !exitEarly; ++i)
     {
-        ArrayTransactionStore *stores[] = {&cardStore, &achStore, &upiStore, &wireStore};
-        string storeNames[] = {"Card Transactions", "ACH Transactions", "UPI Transactions", "Wire Transactions"};
-        for (int i = 0; i < 4 && !exitEarly; ++i)
+        if (results[i].size() > 0)
+            paginateFilteredResults(storeNames[i], *stores[i], results[i], exitEarly, searchMs, searchType, rssBefore, rssAfter);
+    }
+}
+
+// ---------------- LINEAR SEARCH FOR ARRAY & LINKED LIST----------------
+// Collects every row whose transaction_type is flagged in matches, store by
+// store, in the order the store is shown. The transaction_type indexes are
+// in insertion order, so they only serve stores without an active sort;
+// sorted stores are walked through their view. Returns the total match count.
+template <typename Store>
+int collectTypeMatches(Store *const (&stores)[4], const vector<char> &matches, CursorFor<Store> (&results)[4])
+{
+    int total = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        const Store &store = *stores[i];
+        if constexpr (is_same_v<Store, LinkedListTransactionStore>)
         {
-            int left = 0;
-            int right = stores[i]->size() - 1;
-            int matchIndex = -1;
-            while (left <= right)
+            if (store.getSortFields().empty())
+                results[i].collect(store.getTypeIndex(), matches);
+            else
             {
-                int mid = left + (right - left) / 2;
-                string midType = toLower(stores[i]->get(mid).transaction_type);
-                if (midType == searchTermLower)
+                results[i].clear();
+                for (ListNode *curr = store.getHead(); curr; curr = curr->next)
                 {
-                    matchIndex = mid;
-                    found = true;
-                    break;
-                }
-                else if (midType < searchTermLower)
-                {
-                    left = mid + 1;
-                }
-                else
-                {
-                    right = mid - 1;
+                    if (matches[curr->data.transaction_type])
+                        results[i].add(curr);
                 }
             }
-            if (matchIndex != -1)
+        }
+        else if (store.getSortIndex().isInsertionOrder())
+            results[i].collect(store.getTypeIndex(), matches);
+        else
+        {
+            results[i].clear();
+            for (int position = 0; position < store.size(); ++position)
             {
-                double rssAfter = getRSSMemoryUsage();
-                paginateFilteredArrayResults(storeNames[i], *stores[i], searchTermLower, exitEarly, start, "Binary", rssBefore, rssAfter);
+                int row = store.rowAt(position);
+                DictCode code;
+                if constexpr (is_same_v<Store, ColumnarTransactionStore>)
+                    code = store.getTransactionTypeColumn()[row];
+                else
+                    code = store.getRef(row).transaction_type;
+                if (matches[code])
+                    results[i].add(row);
             }
         }
+        total += results[i].size();
     }
-    else
+    return total;
+}
+
+void linearSearchByTransactionType(const string &searchTermLower, double rssBefore)
+{
+    visitChannelStores([&](auto &stores)
+                       {
+        using Store = remove_reference_t<decltype(*stores[0])>;
+        auto start = high_resolution_clock::now();
+        CursorFor<Store> results[4];
+        int total = collectTypeMatches(stores, matchingTransactionTypes(searchTermLower), results);
+        long long searchMs = duration_cast<milliseconds>(high_resolution_clock::now() - start).count();
+
+        if (total > 0)
+            paginateSearchResults(stores, results, searchMs, "Linear", rssBefore);
+        else
+            cout << "No results found.\n"; });
+}
+
+// ---------------- BINARY SEARCH FOR ARRAY & LINKED LIST ----------------
+// Exact-match search on stores sorted by transaction type: each store's
+// equalRange gives the lower/upper bound of the term, and the span between
+// them is the result. Stores sorted on another key are left empty, and the
+// function returns false if there were any.
+template <typename Store>
+bool collectTypeRange(Store *const (&stores)[4], int targetCode, CursorFor<Store> (&results)[4])
+{
+    bool allSorted = true;
+    for (int i = 0; i < 4; ++i)
     {
-        LinkedListTransactionStore *stores[] = {&cardLL, &achLL, &upiLL, &wireLL};
-        string storeNames[] = {"Card Transactions", "ACH Transactions", "UPI Transactions", "Wire Transactions"};
-        for (int i = 0; i < 4 && !exitEarly; ++i)
+        results[i].clear();
+        int first = 0, last = 0;
+        if (!stores[i]->equalRange(SORT_KEY_TRANSACTION_TYPE, targetCode, first, last))
         {
-            int left = 0;
-            int right = stores[i]->size() - 1;
-            int matchIndex = -1;
-            while (left <= right)
-            {
-                int mid = left + (right - left) / 2;
-                ListNode *midNode = stores[i]->getHead();
-                int idx = 0;
-                while (midNode && idx < mid)
-                {
-                    midNode = midNode->next;
-                    idx++;
-                }
-                if (!midNode)
-                    break;
-                string midType = toLower(midNode->data.transaction_type);
-                if (midType == searchTermLower)
-                {
-                    matchIndex = mid;
-                    found = true;
-                    break;
-                }
-                else if (midType < searchTermLower)
-                {
-                    left = mid + 1;
-                }
-                else
-                {
-                    right = mid - 1;
-                }
-            }
-            if (matchIndex != -1)
-            {
-                double rssAfter = getRSSMemoryUsage();
-                paginateFilteredLinkedListResults(storeNames[i], *stores[i], searchTermLower, exitEarly, start, "Binary", rssBefore, rssAfter);
-            }
+            allSorted = false;
+            continue;
+        }
+        if (first == last)
+            continue;
+        if constexpr (is_same_v<Store, LinkedListTransactionStore>)
+        {
+            ListNode *curr = stores[i]->nodeAt(first);
+            for (int position = first; position < last; ++position, curr = curr->next)
+                results[i].add(curr);
+        }
+        else
+        {
+            for (int position = first; position < last; ++position)
+                results[i].add(stores[i]->rowAt(position));
         }
     }
-    if (!found)
+    return allSorted;
+}
+
+void BinarySearchByTransactionType(const string &searchTermLower, double rssBefore)
+{
+    visitChannelStores([&](auto &stores)
+                       {
+        using Store = remove_reference_t<decltype(*stores[0])>;
+        auto start = high_resolution_clock::now();
+        // A term that was never encoded has code -1 and an empty range.
+        int targetCode = fieldDictionaries.transactionType.find(searchTermLower);
+        CursorFor<Store> results[4];
+        bool allSorted = collectTypeRange(stores, targetCode, results);
+        long long searchMs = duration_cast<milliseconds>(high_resolution_clock::now() - start).count();
+
+        int total = 0;
+        for (const auto &result : results)
+            total += result.size();
+        if (total > 0)
+            paginateSearchResults(stores, results, searchMs, "Binary", rssBefore);
+        if (!allSorted)
+        {
+            cout << "[INFO] Binary search needs the stores sorted by Transaction Type "
+                 << "(Sort Menu options 5-8); unsorted stores were skipped.\n";
+        }
+        if (total == 0)
+            cout << "No results found.\n"; });
+}
+
+// ---------------- NUMERIC FILTER ----------------
+// Evaluates predicates on each store's packed numeric columns into a
+// selection bitmap and turns the selected rows into results, in store
+// order. Returns the total match count.
+template <typename Store>
+int collectFilterMatches(Store *const (&stores)[4], const vector<NumericPredicate> &predicates, CursorFor<Store> (&results)[4],
+                         DoubleFilter doubleFilter = bestDoubleFilter(), FlagFilter flagFilter = bestFlagFilter())
+{
+    int total = 0;
+    SelectionBitmap selection;
+    for (int i = 0; i < 4; ++i)
     {
-        cout << "No results found.\n";
+        filterRows(stores[i]->getNumericColumns(), predicates, selection, doubleFilter, flagFilter);
+        if constexpr (is_same_v<Store, LinkedListTransactionStore>)
+            results[i].collectSelected(selection, [&](int row)
+                                       { return stores[i]->numericRowNode(row); });
+        else
+            results[i].collectSelected(selection, [](int row)
+                                       { return row; });
+        total += results[i].size();
     }
+    return total;
+}
+
+void filterByNumericFields(const vector<NumericPredicate> &predicates, double rssBefore)
+{
+    visitChannelStores([&](auto &stores)
+                       {
+        using Store = remove_reference_t<decltype(*stores[0])>;
+        // The array and list stores pack their columns on the first filter
+        // after a load; that one-off copy is not part of the filter time.
+        for (Store *store : stores)
+            store->getNumericColumns();
+
+        auto start = high_resolution_clock::now();
+        CursorFor<Store> results[4];
+        int total = collectFilterMatches(stores, predicates, results);
+        auto elapsed = high_resolution_clock::now() - start;
+
+        cout << "[INFO] " << describePredicates(predicates) << ": " << total << " matches in " << fixed
+             << setprecision(3) << duration<double, milli>(elapsed).count() << " ms (" << numericFilterName() << ")\n";
+        if (total > 0)
+            paginateSearchResults(stores, results, duration_cast<milliseconds>(elapsed).count(), "Filter", rssBefore);
+        else
+            cout << "No results found.\n"; });
 }
 
 // ------------------ SEARCH MENU  ----------------------
@@ -815,7 +1183,8 @@ void handleSearchMenu()
         cout << "\n========= SEARCH MENU =========\n";
         cout << "1. Linear Search by Transaction Type\n";
         cout << "2. Binary Search by Transaction Type (After Sorted)\n";
-        cout << "3. Back to Main Menu\n";
+        cout << "3. Filter by Amount, Scores and Fraud Flag\n";
+        cout << "4. Back to Main Menu\n";
         cout << "Choose an option: ";
         cin >> choice;
 
@@ -827,10 +1196,26 @@ void handleSearchMenu()
             continue;
         }
 
-        if (choice == 3)
+        if (choice == 4)
             return;
 
-        if (choice == 2)
+        if (choice == 3)
+        {
+            cout << "Enter conditions joined by \"and\" on amount, velocity_score, geo_anomaly_score or is_fraud\n"
+                 << "(e.g. amount > 1000 and geo_anomaly_score >= 0.8 and is_fraud): ";
+            cin.ignore();
+
+            double rssBefore = getRSSMemoryUsage();
+
+            string conditions, error;
+            getline(cin, conditions);
+            vector<NumericPredicate> predicates;
+            if (parseNumericPredicates(conditions, predicates, error))
+                filterByNumericFields(predicates, rssBefore);
+            else
+                cout << "Invalid filter: " << error << "\n";
+        }
+        else if (choice == 2)
         {
             cout << "Enter Transaction Type (case-insensitive): ";
             cin.ignore();
@@ -839,7 +1224,7 @@ void handleSearchMenu()
 
             string searchTerm;
             getline(cin, searchTerm);
-            BinarySearchByTransactionType(searchTerm, rssBefore);
+            BinarySearchByTransactionType(toLower(searchTerm), rssBefore);
         }
         else if (choice == 1)
         {
@@ -861,284 +1246,484 @@ void handleSearchMenu()
     } while (true);
 }
 
-// ---------------- BUCKET SORT FOR ARRAY ----------------
-void bucketSortByLocation(ArrayTransactionStore &store, bool reverse = false)
+// ---------------- SORT ENTRIES ----------------
+// One packed key per row, in insertion order. Sorts reorder these entries,
+// never the rows; the result becomes the store's SortIndex.
+vector<SortEntry> buildSortEntries(const ArrayTransactionStore &store, const SortSpec &spec)
+{
+    vector<SortEntry> entries(store.size());
+    for (int i = 0; i < store.size(); ++i)
+        entries[i] = SortEntry{spec.keyOf(store.getRef(i)), i};
+    return entries;
+}
+
+// Only the key columns are read.
+vector<SortEntry> buildSortEntries(const ColumnarTransactionStore &store, const SortSpec &spec)
+{
+    const CountedVector<DictCode> &locations = store.getLocationColumn();
+    const CountedVector<DictCode> &types = store.getTransactionTypeColumn();
+    vector<SortEntry> entries(store.size());
+    for (int i = 0; i < store.size(); ++i)
+    {
+        uint64_t key = spec.keyOf([&](SortKey field)
+                                  { return field == SORT_KEY_TRANSACTION_TYPE ? types[i] : locations[i]; });
+        entries[i] = SortEntry{key, i};
+    }
+    return entries;
+}
+
+// ---------------- BUCKET SORT FOR ARRAY & COLUMNAR ----------------
+// Bucket ids are handed out in first-seen order; this returns them ordered
+// by their key, which is the only comparison sort involved (U log U).
+vector<int> bucketsInKeyOrder(const vector<uint64_t> &bucketKeys)
 {
-    int n = store.size();
+    vector<int> order(bucketKeys.size());
+    for (size_t b = 0; b < order.size(); ++b)
+        order[b] = (int)b;
+    sort(order.begin(), order.end(), [&](int x, int y)
+         { return bucketKeys[x] < bucketKeys[y]; });
+    return order;
+}
+
+// Counting-sort placement: one pass hashes every key to its bucket and
+// counts it, prefix sums turn the counts into output offsets, and a second
+// pass moves each entry exactly once into the pre-sized result. Stable, so
+// entries with equal keys keep their insertion order. O(N + U log U).
+void bucketSortEntries(vector<SortEntry> &entries)
+{
+    int n = entries.size();
     if (n == 0)
         return;
 
-    string *uniqueLocations = new string[n];
-    int uniqueCount = 0;
+    unordered_map<uint64_t, int> bucketOf;
+    vector<uint64_t> bucketKeys;
+    vector<int> bucketSizes;
+    vector<int> bucketIds(n);
     for (int i = 0; i < n; ++i)
     {
-        const string &loc = store.getRef(i).location;
-        bool found = false;
-        for (int j = 0; j < uniqueCount; ++j)
-        {
-            if (uniqueLocations[j] == loc)
-            {
-                found = true;
-                break;
-            }
-        }
-        if (!found)
+        auto inserted = bucketOf.try_emplace(entries[i].key, (int)bucketKeys.size());
+        if (inserted.second)
         {
-            uniqueLocations[uniqueCount++] = loc;
+            bucketKeys.push_back(entries[i].key);
+            bucketSizes.push_back(0);
         }
+        bucketIds[i] = inserted.first->second;
+        bucketSizes[bucketIds[i]]++;
     }
 
-    for (int i = 0; i < uniqueCount - 1; ++i)
+    vector<int> offsets(bucketKeys.size());
+    int next = 0;
+    for (int bucket : bucketsInKeyOrder(bucketKeys))
     {
-        int target = i;
-        for (int j = i + 1; j < uniqueCount; ++j)
-        {
-            if (!reverse)
-            {
-                if (uniqueLocations[j] < uniqueLocations[target])
-                    target = j;
-            }
-            else
-            {
-                if (uniqueLocations[j] > uniqueLocations[target])
-                    target = j;
-            }
-        }
-        if (target != i)
-        {
-            string tmp = uniqueLocations[i];
-            uniqueLocations[i] = uniqueLocations[target];
-            uniqueLocations[target] = tmp;
-        }
+        offsets[bucket] = next;
+        next += bucketSizes[bucket];
     }
 
-    ArrayTransactionStore *buckets = new ArrayTransactionStore[uniqueCount];
+    vector<SortEntry> sorted(n);
     for (int i = 0; i < n; ++i)
-    {
-        const string &loc = store.getRef(i).location;
-        for (int j = 0; j < uniqueCount; j++)
+        sorted[offsets[bucketIds[i]]++] = entries[i];
+    entries.swap(sorted);
+}
+
+// ---------------- BUCKET SORT FOR LINKED LIST ----------------
+// One pass over the nodes in insertion order hashes each key to its bucket
+// and relinks the node onto that bucket's chain; the chains are then joined
+// in key order. No row is copied or allocated.
+void bucketSortByKey(LinkedListTransactionStore &store, const SortSpec &spec)
+{
+    if (store.size() == 0)
+        return;
+
+    unordered_map<uint64_t, int> bucketOf;
+    vector<uint64_t> bucketKeys;
+    vector<ListNode *> bucketHeads, bucketTails;
+    store.forEachInserted([&](ListNode *node)
+                          {
+        uint64_t key = spec.keyOf(node->data);
+        auto inserted = bucketOf.try_emplace(key, (int)bucketKeys.size());
+        int bucket = inserted.first->second;
+        node->next = nullptr;
+        if (inserted.second)
         {
-            if (uniqueLocations[j] == loc)
-            {
-                buckets[j].add(store.getRef(i));
-                break;
-            }
+            bucketKeys.push_back(key);
+            bucketHeads.push_back(node);
+            bucketTails.push_back(node);
         }
+        else
+        {
+            bucketTails[bucket]->next = node;
+            bucketTails[bucket] = node;
+        } });
+
+    ListNode *sortedHead = nullptr, *sortedTail = nullptr;
+    for (int bucket : bucketsInKeyOrder(bucketKeys))
+    {
+        if (!sortedHead)
+            sortedHead = bucketHeads[bucket];
+        else
+            sortedTail->next = bucketHeads[bucket];
+        sortedTail = bucketTails[bucket];
     }
+    store.setHead(sortedHead, spec.getFields());
+}
 
-    store.clear();
-    for (int i = 0; i < uniqueCount; ++i)
+// ---------------- RADIX SORT ----------------
+// The packed rank key already stands in for the strings, so the radix sort
+// runs over its bytes. Only bytes that differ between keys get a pass:
+// with a single key of a few hundred distinct values that is one
+// counting pass.
+#define RADIX_BITS 8
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+
+// Bit positions of the key bytes that are not the same in every key, least
+// significant first.
+template <typename ForEachKey>
+vector<int> varyingRadixShifts(ForEachKey forEachKey)
+{
+    bool first = true;
+    uint64_t firstKey = 0, differing = 0;
+    forEachKey([&](uint64_t key)
+               {
+        if (first)
+            firstKey = key;
+        first = false;
+        differing |= key ^ firstKey; });
+
+    vector<int> shifts;
+    for (int shift = 0; shift < 64; shift += RADIX_BITS)
     {
-        for (int j = 0; j < buckets[i].size(); ++j)
-        {
-            store.add(buckets[i].get(j));
-        }
+        if ((differing >> shift) & (RADIX_BUCKETS - 1))
+            shifts.push_back(shift);
     }
-    delete[] buckets;
-    delete[] uniqueLocations;
+    return shifts;
 }
 
-// ---------------- BUCKET SORT FOR LINKED LIST ----------------
-void bucketSortByLocation(LinkedListTransactionStore &store, bool reverse = false)
+// LSD radix sort of the entries: each pass counts one byte, prefix sums
+// give the bucket offsets and the entries are scattered into a second
+// buffer. Stable, O(N) per varying byte.
+void radixSortEntries(vector<SortEntry> &entries)
 {
-    int n = store.size();
-    if (n == 0)
+    vector<int> shifts = varyingRadixShifts([&](auto visit)
+                                            {
+        for (const SortEntry &entry : entries)
+            visit(entry.key); });
+    if (shifts.empty())
         return;
 
-    string *uniqueLocations = new string[n];
-    int uniqueCount = 0;
-    ListNode *curr = store.getHead();
-    while (curr)
+    vector<SortEntry> buffer(entries.size());
+    for (int shift : shifts)
     {
-        const string &loc = curr->data.location;
-        bool found = false;
-        for (int j = 0; j < uniqueCount; ++j)
+        int offsets[RADIX_BUCKETS] = {};
+        for (const SortEntry &entry : entries)
+            offsets[(entry.key >> shift) & (RADIX_BUCKETS - 1)]++;
+        int next = 0;
+        for (int &offset : offsets)
         {
-            if (uniqueLocations[j] == loc)
-            {
-                found = true;
-                break;
-            }
-        }
-        if (!found)
-        {
-            uniqueLocations[uniqueCount++] = loc;
+            int count = offset;
+            offset = next;
+            next += count;
         }
-        curr = curr->next;
+        for (const SortEntry &entry : entries)
+            buffer[offsets[(entry.key >> shift) & (RADIX_BUCKETS - 1)]++] = entry;
+        entries.swap(buffer);
     }
+}
+
+// Same passes on the linked list: each pass deals the nodes onto one chain
+// per byte value and joins the chains in order. Nodes are relinked, never
+// copied.
+void radixSortByKey(LinkedListTransactionStore &store, const SortSpec &spec)
+{
+    vector<int> shifts = varyingRadixShifts([&](auto visit)
+                                            { store.forEachInserted([&](ListNode *node)
+                                                                    { visit(spec.keyOf(node->data)); }); });
+    store.restoreInsertionOrder();
+    ListNode *head = store.getHead();
 
-    for (int i = 0; i < uniqueCount - 1; ++i)
+    for (int shift : shifts)
     {
-        int target = i;
-        for (int j = i + 1; j < uniqueCount; ++j)
+        ListNode *heads[RADIX_BUCKETS] = {}, *tails[RADIX_BUCKETS] = {};
+        for (ListNode *node = head; node;)
         {
-            if (!reverse)
-            {
-                if (uniqueLocations[j] < uniqueLocations[target])
-                    target = j;
-            }
+            ListNode *next = node->next;
+            int digit = (spec.keyOf(node->data) >> shift) & (RADIX_BUCKETS - 1);
+            node->next = nullptr;
+            if (!heads[digit])
+                heads[digit] = node;
             else
-            {
-                if (uniqueLocations[j] > uniqueLocations[target])
-                    target = j;
-            }
-        }
-        if (target != i)
-        {
-            string tmp = uniqueLocations[i];
-            uniqueLocations[i] = uniqueLocations[target];
-            uniqueLocations[target] = tmp;
+                tails[digit]->next = node;
+            tails[digit] = node;
+            node = next;
         }
-    }
 
-    LinkedListTransactionStore *buckets = new LinkedListTransactionStore[uniqueCount];
-    curr = store.getHead();
-    while (curr)
-    {
-        const string &loc = curr->data.location;
-        for (int j = 0; j < uniqueCount; ++j)
+        ListNode **tail = &head;
+        for (int digit = 0; digit < RADIX_BUCKETS; ++digit)
         {
-            if (uniqueLocations[j] == loc)
-            {
-                buckets[j].add(curr->data);
-                break;
-            }
+            if (!heads[digit])
+                continue;
+            *tail = heads[digit];
+            tail = &tails[digit]->next;
         }
-        curr = curr->next;
     }
+    store.setHead(head, spec.getFields());
+}
 
-    store.clear();
-    for (int i = 0; i < uniqueCount; ++i)
+// ---------------- QUICK SORT FOR ARRAY & COLUMNAR ----------------
+// Introsort over the sort entries; the rows stay where they are. Ranges at
+// or below this size finish with insertion sort.
+#define INSERTION_SORT_THRESHOLD 16
+
+void insertionSortEntries(vector<SortEntry> &entries, int low, int high)
+{
+    for (int i = low + 1; i <= high; ++i)
     {
-        ListNode *node = buckets[i].getHead();
-        while (node)
+        SortEntry entry = entries[i];
+        int j = i - 1;
+        while (j >= low && entries[j].key > entry.key)
         {
-            store.add(node->data);
-            node = node->next;
+            entries[j + 1] = entries[j];
+            --j;
         }
+        entries[j + 1] = entry;
     }
-    delete[] buckets;
-    delete[] uniqueLocations;
 }
 
-// ---------------- QUICK SORT FOR ARRAY  ----------------
-void quickSortInPlace(ArrayTransactionStore &store, int low, int high, bool ascending = true)
+void heapSortEntries(vector<SortEntry> &entries, int low, int high)
 {
-    if (low >= high)
-        return;
+    auto byKey = [](const SortEntry &x, const SortEntry &y)
+    { return x.key < y.key; };
+    make_heap(entries.begin() + low, entries.begin() + high + 1, byKey);
+    sort_heap(entries.begin() + low, entries.begin() + high + 1, byKey);
+}
 
-    string pivot = store.getRef(low).location;
-    int lt = low, gt = high, i = low + 1;
+// Median of three for short ranges, Tukey's ninther (median of three
+// medians spread over the range) for long ones. Already sorted and reverse
+// sorted input both get a middle pivot.
+uint64_t choosePivot(const vector<SortEntry> &entries, int low, int high)
+{
+    int mid = low + (high - low) / 2;
+    auto median = [&](int a, int b, int c)
+    { return medianOfThree(entries[a].key, entries[b].key, entries[c].key); };
+    if (high - low < 128)
+        return median(low, mid, high);
+    int step = (high - low) / 8;
+    return medianOfThree(median(low, low + step, low + 2 * step),
+                         median(mid - step, mid, mid + step),
+                         median(high - 2 * step, high - step, high));
+}
 
-    while (i <= gt)
+// Three-way partitioning keeps long runs of equal keys out of the
+// recursion. Only the smaller side recurses and the loop carries on with
+// the larger, so the stack stays O(log N); once depthLimit partitions have
+// been spent the range is heap sorted, which caps the worst case at
+// O(N log N).
+void introSortEntries(vector<SortEntry> &entries, int low, int high, int depthLimit)
+{
+    while (high - low + 1 > INSERTION_SORT_THRESHOLD)
     {
-        string curr = store.getRef(i).location;
-        bool less = ascending ? (curr < pivot) : (curr > pivot);
-        bool greater = ascending ? (curr > pivot) : (curr < pivot);
+        if (depthLimit-- == 0)
+        {
+            heapSortEntries(entries, low, high);
+            return;
+        }
 
-        if (less)
+        uint64_t pivot = choosePivot(entries, low, high);
+        int lt = low, gt = high, i = low;
+        while (i <= gt)
         {
-            if (lt != i)
-                swap(store.getRef(lt), store.getRef(i));
-            ++lt;
-            ++i;
+            uint64_t curr = entries[i].key;
+            if (curr < pivot)
+                swap(entries[lt++], entries[i++]);
+            else if (curr > pivot)
+                swap(entries[i], entries[gt--]);
+            else
+                ++i;
         }
-        else if (greater)
+
+        if (lt - low < high - gt)
         {
-            if (i != gt)
-                swap(store.getRef(i), store.getRef(gt));
-            --gt;
+            introSortEntries(entries, low, lt - 1, depthLimit);
+            low = gt + 1;
         }
         else
         {
-            ++i;
+            introSortEntries(entries, gt + 1, high, depthLimit);
+            high = lt - 1;
         }
     }
+    insertionSortEntries(entries, low, high);
+}
 
-    quickSortInPlace(store, low, lt - 1, ascending);
-    quickSortInPlace(store, gt + 1, high, ascending);
+// Sorts the inclusive range [low, high] by key.
+void quickSortEntries(vector<SortEntry> &entries, int low, int high)
+{
+    if (low >= high)
+        return;
+    int depthLimit = 0;
+    for (int n = high - low + 1; n > 1; n >>= 1)
+        depthLimit += 2;
+    introSortEntries(entries, low, high, depthLimit);
+}
+
+// ---------------- MERGE SORT FOR LINKED LIST ----------------
+// Detaches the first count nodes starting at run and returns the node after
+// them.
+ListNode *splitRun(ListNode *run, int count)
+{
+    for (int i = 1; run && i < count; ++i)
+        run = run->next;
+    if (!run)
+        return nullptr;
+    ListNode *rest = run->next;
+    run->next = nullptr;
+    return rest;
 }
 
-// ---------------- QUICK SORT FOR LINKED LIST ----------------
-ListNode *quickSortList(ListNode *head, bool ascending = true)
+// Stable merge of two runs onto *tail, taking from left on ties. Returns
+// the next field of the merged run's last node, where the next run goes.
+ListNode **mergeRuns(ListNode *left, ListNode *right, ListNode **tail, const SortSpec &spec)
 {
-    if (!head || !head->next)
-        return head;
-    string pivot = head->data.location;
-    ListNode *lh = nullptr, *lt = nullptr, *eh = nullptr, *et = nullptr, *gh = nullptr, *gt = nullptr;
-    for (ListNode *cur = head; cur;)
+    uint64_t leftKey = left ? spec.keyOf(left->data) : 0;
+    uint64_t rightKey = right ? spec.keyOf(right->data) : 0;
+    while (left && right)
     {
-        ListNode *nx = cur->next;
-        cur->next = nullptr;
-        bool less = ascending ? (cur->data.location < pivot) : (cur->data.location > pivot);
-        bool greater = ascending ? (cur->data.location > pivot) : (cur->data.location < pivot);
-        if (less)
-        {
-            if (!lh)
-                lh = lt = cur;
-            else
-                lt = lt->next = cur;
-        }
-        else if (greater)
+        if (rightKey < leftKey)
         {
-            if (!gh)
-                gh = gt = cur;
-            else
-                gt = gt->next = cur;
+            *tail = right;
+            right = right->next;
+            if (right)
+                rightKey = spec.keyOf(right->data);
         }
         else
         {
-            if (!eh)
-                eh = et = cur;
-            else
-                et = et->next = cur;
+            *tail = left;
+            left = left->next;
+            if (left)
+                leftKey = spec.keyOf(left->data);
         }
-        cur = nx;
+        tail = &(*tail)->next;
     }
-    lh = quickSortList(lh, ascending);
-    gh = quickSortList(gh, ascending);
+    *tail = left ? left : right;
+    while (*tail)
+        tail = &(*tail)->next;
+    return tail;
+}
 
-    ListNode *nh = nullptr, *nt = nullptr;
-    auto append = [&](ListNode *x)
+// Bottom-up merge sort: passes merge neighbouring runs of width 1, 2, 4, ...
+// by relinking next pointers. Iterative, stable, O(N log N) on any input
+// and O(1) extra space; no Transaction is copied.
+ListNode *mergeSortList(ListNode *head, int length, const SortSpec &spec)
+{
+    for (int width = 1; width < length; width *= 2)
     {
-        if (!x)
-            return;
-        if (!nh)
-            nh = x;
-        else
-            nt->next = x;
-        nt = x;
-        while (nt->next)
-            nt = nt->next;
-    };
-    append(lh);
-    append(eh);
-    append(gh);
-    return nh;
+        ListNode *rest = head;
+        ListNode **tail = &head;
+        while (rest)
+        {
+            ListNode *left = rest;
+            ListNode *right = splitRun(left, width);
+            rest = splitRun(right, width);
+            tail = mergeRuns(left, right, tail, spec);
+        }
+    }
+    return head;
 }
 
-void quickSort(LinkedListTransactionStore &store, bool ascending = true)
+// Like the other stores, every sort starts from insertion order.
+void mergeSort(LinkedListTransactionStore &store, const SortSpec &spec)
 {
-    ListNode *sorted = quickSortList(store.getHead(), ascending);
-    store.setHead(sorted);
+    store.restoreInsertionOrder();
+    ListNode *sorted = mergeSortList(store.getHead(), store.size(), spec);
+    store.setHead(sorted, spec.getFields());
 }
 
 // ------------------ SORT MENU ----------------------
-void handleSortMenu()
+// Shared by every sort: the channel stores are sorted side by side and each
+// large quick or merge sort spreads its own partitions over the same workers.
+WorkStealingPool &sortPool()
 {
-    int choice;
-    do
-    {
-        cout << "\n========= SORT MENU =========\n";
-        cout << "1. Bucket Sort by Location (A-Z)\n";
-        cout << "2. Bucket Sort by Location (Z-A)\n";
-        cout << "3. Quick Sort by Location (A-Z)\n";
-        cout << "4. Quick Sort by Location (Z-A)\n";
-        cout << "5. Back to Main Menu\n";
-        cout << "Choose an option: ";
-        cin >> choice;
+    static WorkStealingPool pool(ingestThreadCount());
+    return pool;
+}
 
-        if (cin.fail())
+enum SortAlgorithm
+{
+    SORT_BUCKET,
+    SORT_QUICK,
+    SORT_MERGE,
+    SORT_RADIX
+};
+
+// Sorts the entries of an array or columnar store and installs the result
+// as its view.
+template <typename Store>
+void applySort(Store &store, const SortSpec &spec, SortAlgorithm algorithm)
+{
+    vector<SortEntry> entries = buildSortEntries(store, spec);
+    if (algorithm == SORT_QUICK)
+        parallelQuickSort(entries, sortPool(), quickSortEntries);
+    else if (algorithm == SORT_MERGE)
+        parallelMergeSort(entries, sortPool());
+    else if (algorithm == SORT_RADIX)
+        radixSortEntries(entries);
+    else
+        bucketSortEntries(entries);
+    SortIndex index(entries, spec.getFields());
+    store.swapSortIndex(index);
+}
+
+void applySort(LinkedListTransactionStore &store, const SortSpec &spec, SortAlgorithm algorithm)
+{
+    if (algorithm == SORT_MERGE)
+        mergeSort(store, spec);
+    else if (algorithm == SORT_RADIX)
+        radixSortByKey(store, spec);
+    else
+        bucketSortByKey(store, spec);
+}
+
+// Sorts (or restores) every store of one mode concurrently on the sort pool.
+template <typename Store>
+void sortStores(Store *const (&stores)[4], const SortSpec &spec, SortAlgorithm algorithm, bool restore)
+{
+    TaskGroup group(sortPool());
+    for (Store *store : stores)
+    {
+        group.run([store, &spec, algorithm, restore]
+                  {
+            if (!restore)
+                applySort(*store, spec, algorithm);
+            else if constexpr (is_same_v<Store, LinkedListTransactionStore>)
+                store->restoreInsertionOrder();
+            else
+                store->clearSortIndex(); });
+    }
+    group.wait();
+}
+
+void handleSortMenu()
+{
+    int choice;
+    do
+    {
+        cout << "\n========= SORT MENU =========\n";
+        cout << "1. Bucket Sort by Location (A-Z)\n";
+        cout << "2. Bucket Sort by Location (Z-A)\n";
+        cout << "3. Quick Sort by Location (A-Z)\n";
+        cout << "4. Quick Sort by Location (Z-A)\n";
+        cout << "5. Bucket Sort by Transaction Type (A-Z)\n";
+        cout << "6. Bucket Sort by Transaction Type (Z-A)\n";
+        cout << "7. Quick Sort by Transaction Type (A-Z)\n";
+        cout << "8. Quick Sort by Transaction Type (Z-A)\n";
+        cout << "9. Merge Sort by Location, then Transaction Type (A-Z)\n";
+        cout << "10. Radix Sort by Location (A-Z)\n";
+        cout << "11. Radix Sort by Location (Z-A)\n";
+        cout << "12. Restore Original Order\n";
+        cout << "13. Back to Main Menu\n";
+        cout << "Choose an option: ";
+        cin >> choice;
+
+        if (cin.fail())
         {
             cin.clear();
             cin.ignore();
@@ -1146,53 +1731,79 @@ void handleSortMenu()
             continue;
         }
 
-        if (choice == 5)
+        if (choice == 13)
             return;
 
-        bool isQuickSort = (choice == 3 || choice == 4);
-        bool reverse = (choice == 2 || choice == 4);
+        if (choice < 1 || choice > 13)
+        {
+            cout << "Invalid choice. Please try again.\n";
+            continue;
+        }
 
-        if (!isLinkedMode)
+        // Options 5-8 repeat 1-4 on the transaction_type key.
+        bool restore = (choice == 12);
+        SortKey key = (choice >= 5 && choice <= 8) ? SORT_KEY_TRANSACTION_TYPE : SORT_KEY_LOCATION;
+        int variant = (choice - 1) % 4 + 1;
+        bool isQuickSort = choice <= 8 && (variant == 3 || variant == 4);
+        SortAlgorithm algorithm = choice == 9                  ? SORT_MERGE
+                                  : choice == 10 || choice == 11 ? SORT_RADIX
+                                  : isQuickSort                  ? SORT_QUICK
+                                                                 : SORT_BUCKET;
+        // Lists have no random access for a quick sort; merge sort is their
+        // comparison sort.
+        if (isLinkedMode && algorithm == SORT_QUICK)
+            algorithm = SORT_MERGE;
+        bool reverse = (choice <= 8 && (variant == 2 || variant == 4)) || choice == 11;
+        SortSpec spec = choice == 9 ? SortSpec{{SORT_KEY_LOCATION, true}, {SORT_KEY_TRANSACTION_TYPE, true}}
+                                    : SortSpec{{key, !reverse}};
+
+        string label = restore       ? string("Restore Original Order")
+                       : algorithm == SORT_QUICK ? "Quick Sort by " + spec.describe()
+                       : algorithm == SORT_MERGE ? "Merge Sort by " + spec.describe()
+                       : algorithm == SORT_RADIX ? "Radix Sort by " + spec.describe()
+                                                 : "Bucket Sort by " + spec.describe();
+
+        if (isColumnarMode)
         {
             auto start = high_resolution_clock::now();
 
-            double rssBefore = 0.0, rssAfter = 0.0;
-            if (isQuickSort)
-            {
-                rssBefore = getRSSMemoryUsage();
-                int n = cardStore.size();
-                quickSortInPlace(cardStore, 0, n - 1, !reverse);
+            double rssBefore = getRSSMemoryUsage();
+            ColumnarTransactionStore *const stores[] = {&cardColumns, &achColumns, &upiColumns, &wireColumns};
+            sortStores(stores, spec, algorithm, restore);
+            double rssAfter = getRSSMemoryUsage();
 
-                n = achStore.size();
-                quickSortInPlace(achStore, 0, n - 1, !reverse);
+            auto end = high_resolution_clock::now();
+            auto duration = duration_cast<milliseconds>(end - start);
 
-                n = upiStore.size();
-                quickSortInPlace(upiStore, 0, n - 1, !reverse);
+            cout << "\n[COLUMNAR] " << label << " Time: " << duration.count() << " ms\n";
+            printSpaceUsage();
+            printMemoryUsageComparison(rssBefore, rssAfter);
 
-                n = wireStore.size();
-                quickSortInPlace(wireStore, 0, n - 1, !reverse);
+            bool exitEarly = false;
+            paginateColumnarResults("Card Transactions", cardColumns, exitEarly);
+            if (exitEarly)
+                return;
+            paginateColumnarResults("ACH Transactions", achColumns, exitEarly);
+            if (exitEarly)
+                return;
+            paginateColumnarResults("UPI Transactions", upiColumns, exitEarly);
+            if (exitEarly)
+                return;
+            paginateColumnarResults("Wire Transactions", wireColumns, exitEarly);
+        }
+        else if (!isLinkedMode)
+        {
+            auto start = high_resolution_clock::now();
 
-                rssAfter = getRSSMemoryUsage();
-            }
-            else
-            {
-                rssBefore = getRSSMemoryUsage();
-                bucketSortByLocation(cardStore, reverse);
-                bucketSortByLocation(achStore, reverse);
-                bucketSortByLocation(upiStore, reverse);
-                bucketSortByLocation(wireStore, reverse);
-                rssAfter = getRSSMemoryUsage();
-            }
+            double rssBefore = getRSSMemoryUsage();
+            ArrayTransactionStore *const stores[] = {&cardStore, &achStore, &upiStore, &wireStore};
+            sortStores(stores, spec, algorithm, restore);
+            double rssAfter = getRSSMemoryUsage();
 
             auto end = high_resolution_clock::now();
             auto duration = duration_cast<milliseconds>(end - start);
 
-            cout << "\n[ARRAY] ";
-            if (isQuickSort)
-                cout << "Quick Sort";
-            else
-                cout << "Bucket Sort";
-            cout << " Time: " << duration.count() << " ms\n";
+            cout << "\n[ARRAY] " << label << " Time: " << duration.count() << " ms\n";
             printSpaceUsage();
             printMemoryUsageComparison(rssBefore, rssAfter);
 
@@ -1212,35 +1823,15 @@ void handleSortMenu()
         {
             auto start = high_resolution_clock::now();
 
-            double rssBefore = 0.0, rssAfter = 0.0;
-            if (isQuickSort)
-            {
-                rssBefore = getRSSMemoryUsage();
-                quickSort(cardLL, !reverse);
-                quickSort(achLL, !reverse);
-                quickSort(upiLL, !reverse);
-                quickSort(wireLL, !reverse);
-                rssAfter = getRSSMemoryUsage();
-            }
-            else
-            {
-                rssBefore = getRSSMemoryUsage();
-                bucketSortByLocation(cardLL, reverse);
-                bucketSortByLocation(achLL, reverse);
-                bucketSortByLocation(upiLL, reverse);
-                bucketSortByLocation(wireLL, reverse);
-                rssAfter = getRSSMemoryUsage();
-            }
+            double rssBefore = getRSSMemoryUsage();
+            LinkedListTransactionStore *const stores[] = {&cardLL, &achLL, &upiLL, &wireLL};
+            sortStores(stores, spec, algorithm, restore);
+            double rssAfter = getRSSMemoryUsage();
 
             auto end = high_resolution_clock::now();
             auto duration = duration_cast<milliseconds>(end - start);
 
-            cout << "\n[LINKED LIST] ";
-            if (isQuickSort)
-                cout << "Quick Sort";
-            else
-                cout << "Bucket Sort";
-            cout << " Time: " << duration.count() << " ms\n";
+            cout << "\n[LINKED LIST] " << label << " Time: " << duration.count() << " ms\n";
             printSpaceUsage();
             printMemoryUsageComparison(rssBefore, rssAfter);
 
@@ -1260,19 +1851,875 @@ void handleSortMenu()
     } while (true);
 }
 
+// ------------------ BENCHMARKS ----------------------
+// Best-of-N wall time of pass() in milliseconds.
+template <typename Pass>
+double bestTimeMs(int repeats, Pass pass)
+{
+    double best = 0.0;
+    for (int r = 0; r < repeats; ++r)
+    {
+        auto begin = high_resolution_clock::now();
+        pass();
+        double ms = duration<double, milli>(high_resolution_clock::now() - begin).count();
+        if (r == 0 || ms < best)
+            best = ms;
+    }
+    return best;
+}
+
+void printBenchmarkRow(const string &stage, double baselineMs, double newMs, size_t bytes)
+{
+    cout << left << setw(22) << stage << right << fixed << setprecision(2)
+         << setw(12) << baselineMs << setw(12) << newMs
+         << setw(10) << (newMs > 0 ? baselineMs / newMs : 0.0) << "x"
+         << setw(12) << (newMs > 0 ? bytes / (newMs * 1000.0) : 0.0) << " MB/s\n";
+}
+
+// Compares the scalar splitter + strtod against the vectorized splitter +
+// from_chars on every line of the given CSV, then times the full row parse.
+void runParserBenchmark(const string &filename)
+{
+    MappedFile file;
+    if (!file.open(filename))
+    {
+        cerr << "Error opening file.\n";
+        return;
+    }
+
+    string_view data = file.view();
+    vector<string_view> lines;
+    size_t pos = data.find('\n');
+    pos = (pos == string_view::npos) ? data.size() : pos + 1;
+    while (pos < data.size())
+    {
+        size_t eol = data.find('\n', pos);
+        if (eol == string_view::npos)
+            eol = data.size();
+        string_view line = data.substr(pos, eol - pos);
+        pos = eol + 1;
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        if (!line.empty())
+            lines.push_back(line);
+    }
+
+    size_t bytes = data.size();
+    const int repeats = 5;
+    string_view fields[TRANSACTION_FIELD_COUNT];
+
+    size_t scalarCheck = 0, simdCheck = 0;
+    double scalarSplit = bestTimeMs(repeats, [&]()
+                                    {
+        scalarCheck = 0;
+        for (string_view line : lines)
+            if (splitTransactionFields(line, fields, findCommasScalar))
+                scalarCheck += fields[TRANSACTION_FIELD_COUNT - 1].size() + fields[4].size(); });
+    double simdSplit = bestTimeMs(repeats, [&]()
+                                  {
+        simdCheck = 0;
+        for (string_view line : lines)
+            if (splitTransactionFields(line, fields))
+                simdCheck += fields[TRANSACTION_FIELD_COUNT - 1].size() + fields[4].size(); });
+
+    // Number conversion is timed on pre-split fields so it is measured alone.
+    vector<string_view> numbers;
+    numbers.reserve(lines.size() * 3);
+    for (string_view line : lines)
+    {
+        if (splitTransactionFields(line, fields))
+        {
+            numbers.push_back(fields[4]);
+            numbers.push_back(fields[13]);
+            numbers.push_back(fields[14]);
+        }
+    }
+    double strtodSum = 0.0, fastSum = 0.0;
+    double strtodTime = bestTimeMs(repeats, [&]()
+                                   {
+        strtodSum = 0.0;
+        for (string_view field : numbers)
+            strtodSum += parseDoubleStrtod(field); });
+    double fastTime = bestTimeMs(repeats, [&]()
+                                 {
+        fastSum = 0.0;
+        for (string_view field : numbers)
+            fastSum += parseDoubleFast(field); });
+
+    double fullParse = bestTimeMs(repeats, [&]()
+                                  {
+        TransactionDictionaries scratch;
+        for (string_view line : lines)
+            if (splitTransactionFields(line, fields))
+                parseTransaction(fields, scratch); });
+
+    cout << "\nParser benchmark: " << filename << " (" << lines.size() << " rows, "
+         << bytes << " bytes, best of " << repeats << ", splitter: " << commaFinderName() << ")\n";
+    cout << left << setw(22) << "Stage" << right << setw(12) << "Old (ms)" << setw(12) << "New (ms)"
+         << setw(11) << "Speedup" << setw(17) << "New throughput\n";
+    printBenchmarkRow("Field splitting", scalarSplit, simdSplit, bytes);
+    printBenchmarkRow("Number conversion", strtodTime, fastTime, bytes);
+    cout << left << setw(22) << "Full row parse" << right << setw(12) << "-" << setw(12) << fullParse
+         << setw(11) << "" << setw(12) << (fullParse > 0 ? lines.size() / fullParse / 1000.0 : 0.0) << " M rows/s\n";
+    if (scalarCheck != simdCheck || strtodSum != fastSum)
+        cout << "[WARN] Old and new parsers disagree on this file.\n";
+}
+
+// ------------------ FRAUD ANALYTICS ----------------------
+// Below this many rows per worker a store is not worth splitting.
+#define AGGREGATION_MIN_SLICE_ROWS (1 << 16)
+
+// Aggregates every channel store of one mode in a single pass. The rows of
+// the four stores are cut into one contiguous slice per worker, each
+// aggregated into its own partial, and the partials are merged at the end.
+// Lists cannot be sliced, so each list is one task.
+template <typename Store>
+FraudAggregation aggregateStores(Store *const (&stores)[4], GroupByField field)
+{
+    vector<FraudAggregation> partials;
+    TaskGroup group(sortPool());
+    if constexpr (is_same_v<Store, LinkedListTransactionStore>)
+    {
+        partials.resize(4);
+        for (int c = 0; c < 4; ++c)
+            group.run([&, c]
+                      { aggregateRows(*stores[c], c, field, partials[c]); });
+    }
+    else
+    {
+        long long totalRows = 0;
+        for (Store *store : stores)
+            totalRows += store->size();
+        long long slices = min<long long>(max<long long>(totalRows / AGGREGATION_MIN_SLICE_ROWS, 1), sortPool().size());
+        partials.resize((size_t)slices);
+        for (long long s = 0; s < slices; ++s)
+        {
+            long long begin = totalRows * s / slices, end = totalRows * (s + 1) / slices;
+            group.run([&, s, begin, end]
+                      {
+                long long offset = 0;
+                for (int c = 0; c < 4; ++c)
+                {
+                    long long first = max(begin, offset), last = min(end, offset + stores[c]->size());
+                    if (first < last)
+                        aggregateRows(*stores[c], c, (int)(first - offset), (int)(last - offset), field, partials[s]);
+                    offset += stores[c]->size();
+                } });
+        }
+    }
+    group.wait();
+
+    FraudAggregation result;
+    for (const FraudAggregation &partial : partials)
+        result.merge(partial);
+    return result;
+}
+
+void printGroupRow(const string &label, const GroupStats &stats)
+{
+    int fraudType = stats.topFraudType();
+    cout << left << setw(18) << label.substr(0, 17) << right << fixed << setprecision(2)
+         << setw(10) << stats.rows << setw(8) << stats.fraudRows << setw(9) << stats.fraudRate() * 100.0
+         << setw(16) << stats.amountSum << setw(10) << stats.amountAverage()
+         << setw(10) << stats.amountPercentile(50) << setw(10) << stats.amountPercentile(90)
+         << setw(10) << stats.amountPercentile(99)
+         << setw(9) << (stats.rows > 0 ? stats.velocitySum / stats.rows : 0.0)
+         << setw(9) << setprecision(4) << (stats.rows > 0 ? stats.geoAnomalySum / stats.rows : 0.0)
+         << "  " << (fraudType >= 0 ? fieldDictionaries.fraudType.decode(fraudType) : string("-")) << "\n";
+}
+
+void printHistogramRow(const string &label, const long long (&bins)[SCORE_HISTOGRAM_BINS], long long rows)
+{
+    cout << left << setw(18) << label.substr(0, 17) << right << fixed << setprecision(1);
+    for (long long count : bins)
+        cout << setw(7) << (rows > 0 ? count * 100.0 / rows : 0.0);
+    cout << "\n";
+}
+
+// Metrics table, then the score histograms as a percentage of each group's
+// rows. Groups are listed by name.
+void printFraudAnalytics(const FraudAggregation &aggregation, GroupByField field)
+{
+    vector<pair<string, const GroupStats *>> groups;
+    for (size_t key = 0; key < aggregation.getGroups().size(); ++key)
+    {
+        if (aggregation.getGroups()[key].rows > 0)
+            groups.push_back({groupLabel(field, key), &aggregation.getGroups()[key]});
+    }
+    sort(groups.begin(), groups.end(), [](const auto &x, const auto &y)
+         { return x.first < y.first; });
+    GroupStats total = aggregation.total();
+
+    cout << "\n--- Fraud Analytics by " << groupByFieldName(field) << " (amount percentiles within 3%) ---\n";
+    cout << left << setw(18) << groupByFieldName(field) << right << setw(10) << "Rows" << setw(8) << "Fraud"
+         << setw(9) << "Fraud %" << setw(16) << "Amount Sum" << setw(10) << "Avg" << setw(10) << "P50"
+         << setw(10) << "P90" << setw(10) << "P99" << setw(9) << "Avg Vel" << setw(9) << "Avg Geo"
+         << "  Top Fraud Type\n";
+    for (const auto &[label, stats] : groups)
+        printGroupRow(label, *stats);
+    printGroupRow("All", total);
+
+    cout << "\ngeo_anomaly_score histogram (% of rows per 0.1 bin)\n" << left << setw(18) << "";
+    for (int b = 0; b < SCORE_HISTOGRAM_BINS; ++b)
+        cout << right << setw(7) << fixed << setprecision(1) << b / 10.0;
+    cout << "\n";
+    for (const auto &[label, stats] : groups)
+        printHistogramRow(label, stats->geoAnomalyHistogram, stats->rows);
+    printHistogramRow("All", total.geoAnomalyHistogram, total.rows);
+
+    cout << "\nvelocity_score histogram (% of rows per bin of 2)\n" << left << setw(18) << "";
+    for (int b = 0; b < SCORE_HISTOGRAM_BINS; ++b)
+        cout << right << setw(7) << (b < SCORE_HISTOGRAM_BINS - 1 ? to_string(b * 2) : to_string(b * 2) + "+");
+    cout << "\n";
+    for (const auto &[label, stats] : groups)
+        printHistogramRow(label, stats->velocityHistogram, stats->rows);
+    printHistogramRow("All", total.velocityHistogram, total.rows);
+}
+
+void handleAnalyticsMenu()
+{
+    int choice;
+    do
+    {
+        cout << "\n========= FRAUD ANALYTICS MENU =========\n";
+        cout << "1. Group by Payment Channel\n";
+        cout << "2. Group by Location\n";
+        cout << "3. Group by Merchant Category\n";
+        cout << "4. Group by Device Used\n";
+        cout << "5. Back to Main Menu\n";
+        cout << "Choose an option: ";
+        cin >> choice;
+
+        if (cin.fail())
+        {
+            cin.clear();
+            cin.ignore();
+            cout << "Invalid input. Try again.\n";
+            continue;
+        }
+
+        if (choice == 5)
+            return;
+
+        if (choice < 1 || choice > 5)
+        {
+            cout << "Invalid choice. Please try again.\n";
+            continue;
+        }
+
+        GroupByField fields[] = {GROUP_BY_CHANNEL, GROUP_BY_LOCATION, GROUP_BY_MERCHANT_CATEGORY, GROUP_BY_DEVICE_USED};
+        GroupByField field = fields[choice - 1];
+        double rssBefore = getRSSMemoryUsage();
+        auto start = high_resolution_clock::now();
+        FraudAggregation aggregation;
+        const char *label = isColumnarMode ? "COLUMNAR" : isLinkedMode ? "LINKED LIST"
+                                                                        : "ARRAY";
+        visitChannelStores([&](auto &stores)
+                           { aggregation = aggregateStores(stores, field); });
+        auto duration = duration_cast<milliseconds>(high_resolution_clock::now() - start);
+        double rssAfter = getRSSMemoryUsage();
+
+        printFraudAnalytics(aggregation, field);
+        cout << "\n[" << label << "] Fraud Analytics Time: " << duration.count() << " ms\n";
+        printSpaceUsage();
+        printMemoryUsageComparison(rssBefore, rssAfter);
+    } while (true);
+}
+
+// ------------------ EXPORT MENU ----------------------
+void handleExportMenu()
+{
+    int choice;
+    while (true)
+    {
+        cout << "\n========= EXPORT MENU =========\n";
+        cout << "1. JSON (pretty-printed array)\n";
+        cout << "2. Compact JSON (array, no whitespace)\n";
+        cout << "3. NDJSON (one object per line)\n";
+        cout << "4. CBOR (one map per row)\n";
+        cout << "5. MessagePack (one map per row)\n";
+        cout << "6. Back to Main Menu\n";
+        cout << "Choose an option: ";
+        cin >> choice;
+
+        if (cin.fail())
+        {
+            cin.clear();
+            cin.ignore();
+            cout << "Invalid input. Try again.\n";
+            continue;
+        }
+
+        if (choice == 6)
+            return;
+
+        if (choice < 1 || choice > 6)
+        {
+            cout << "Invalid choice. Please try again.\n";
+            continue;
+        }
+
+        ExportFormat formats[] = {EXPORT_JSON_PRETTY, EXPORT_JSON_COMPACT, EXPORT_NDJSON, EXPORT_CBOR, EXPORT_MSGPACK};
+        ExportFormat format = formats[choice - 1];
+        if (isColumnarMode)
+        {
+            ColumnarTransactionStore *const stores[] = {&cardColumns, &achColumns, &upiColumns, &wireColumns};
+            exportChannels("columnar", stores, format);
+        }
+        else if (isLinkedMode)
+        {
+            LinkedListTransactionStore *const stores[] = {&cardLL, &achLL, &upiLL, &wireLL};
+            exportChannels("linked", stores, format);
+        }
+        else
+        {
+            ArrayTransactionStore *const stores[] = {&cardStore, &achStore, &upiStore, &wireStore};
+            exportChannels("array", stores, format);
+        }
+        return;
+    }
+}
+
 // --------------- Main Menu --------------------
 void displayMainMenu()
 {
     cout << "\n========= MAIN MENU =========\n";
     cout << "1. Search\n";
     cout << "2. Sort\n";
-    cout << "3. Export all to JSON\n";
-    cout << "4. Exit\n";
+    cout << "3. Export\n";
+    cout << "4. Fraud Analytics\n";
+    cout << "5. Exit\n";
     cout << "Choose an option: ";
 }
 
-int main()
+// Times quickSortEntries on random, sorted, reverse sorted and few-key
+// inputs at three sizes. The last column divides by N log2 N: it stays
+// flat across sizes when the sort is O(N log N) and would grow linearly
+// with N if an input drove it quadratic. Then compares the quick, bucket
+// and radix sorts on the same rank keys.
+void runSortBenchmark(int rows)
 {
+    if (rows < 100)
+        rows = 100;
+    const int repeats = 3;
+    const char *patterns[] = {"Random", "Sorted", "Reverse sorted", "Few distinct keys"};
+
+    cout << "\nSort benchmark: quickSortEntries (best of " << repeats << ")\n";
+    cout << left << setw(20) << "Input" << right << setw(10) << "Rows" << setw(12) << "Time (ms)"
+         << setw(16) << "std::sort (ms)" << setw(18) << "ns / N log2 N\n";
+    for (int p = 0; p < 4; ++p)
+    {
+        for (int n : {rows / 100, rows / 10, rows})
+        {
+            mt19937_64 random(n);
+            vector<SortEntry> input(n);
+            for (int i = 0; i < n; ++i)
+            {
+                uint64_t key = p == 0 ? random() : p == 1 ? (uint64_t)i
+                                               : p == 2   ? (uint64_t)(n - i)
+                                                          : random() % 8;
+                input[i] = SortEntry{key, i};
+            }
+
+            vector<SortEntry> entries;
+            double ms = bestTimeMs(repeats, [&]()
+                                   {
+                entries = input;
+                quickSortEntries(entries, 0, n - 1); });
+            bool sorted = true;
+            for (int i = 1; i < n; ++i)
+                sorted = sorted && entries[i - 1].key <= entries[i].key;
+            double reference = bestTimeMs(repeats, [&]()
+                                          {
+                entries = input;
+                sort(entries.begin(), entries.end(), [](const SortEntry &x, const SortEntry &y)
+                     { return x.key < y.key; }); });
+
+            double nLogN = n * log2((double)n);
+            cout << left << setw(20) << patterns[p] << right << setw(10) << n << fixed << setprecision(2)
+                 << setw(12) << ms << setw(16) << reference << setw(17) << ms * 1e6 / nLogN << "\n";
+            if (!sorted)
+                cout << "[WARN] " << patterns[p] << " input came back unsorted.\n";
+        }
+    }
+
+    // The three entry sorts on rank keys shaped like the menu's: one field
+    // with few or many distinct values, and two packed fields.
+    const char *keyShapes[] = {"8 locations", "4096 locations", "Location + type"};
+    cout << "\nSort algorithms on " << rows << " rank keys (best of " << repeats << ")\n";
+    cout << left << setw(20) << "Keys" << right << setw(12) << "Quick (ms)" << setw(13) << "Bucket (ms)"
+         << setw(12) << "Radix (ms)" << "\n";
+    for (int k = 0; k < 3; ++k)
+    {
+        mt19937_64 random(k);
+        vector<SortEntry> input(rows);
+        for (int i = 0; i < rows; ++i)
+        {
+            uint64_t key = k == 0 ? random() % 8 : k == 1 ? random() % 4096
+                                                          : (random() % 4096) << 32 | random() % 16;
+            input[i] = SortEntry{key, i};
+        }
+
+        vector<SortEntry> quick, bucket, radix;
+        double quickMs = bestTimeMs(repeats, [&]()
+                                    {
+            quick = input;
+            quickSortEntries(quick, 0, rows - 1); });
+        double bucketMs = bestTimeMs(repeats, [&]()
+                                     {
+            bucket = input;
+            bucketSortEntries(bucket); });
+        double radixMs = bestTimeMs(repeats, [&]()
+                                    {
+            radix = input;
+            radixSortEntries(radix); });
+
+        cout << left << setw(20) << keyShapes[k] << right << fixed << setprecision(2) << setw(12) << quickMs
+             << setw(13) << bucketMs << setw(12) << radixMs << "\n";
+        bool same = true;
+        for (int i = 0; i < rows; ++i)
+            same = same && bucket[i].row == radix[i].row && quick[i].key == radix[i].key;
+        if (!same)
+            cout << "[WARN] " << keyShapes[k] << ": the sorts disagree.\n";
+    }
+}
+
+// ------------------ HEADLESS BENCHMARK ----------------------
+// Width of the stage column in the progress lines: the longest stage name,
+// "numeric_filter_scalar".
+#define BENCHMARK_STAGE_WIDTH 21
+
+// Options of --bench. Without a csv path a synthetic dataset is generated
+// from data.
+struct BenchmarkOptions
+{
+    SyntheticDataSpec data;
+    int repeats = 5;
+    vector<string> modes = {"array", "linked", "columnar"};
+    string csv;
+    string out;
+};
+
+// Wall times of every repeat of one stage in one mode, and the memory
+// picture right after its last repeat.
+struct StageResult
+{
+    string mode;
+    string stage;
+    vector<double> ms;
+    ProcessMemory memory;
+    long long allocatedBytes = 0;
+    long long peakAllocatedBytes = 0;
+    size_t storeBytes = 0;
+};
+
+// Discards everything written to cout while alive: the stages reuse the
+// interactive code paths, which print their usual summaries.
+class SilencedStdout
+{
+private:
+    streambuf *saved;
+
+public:
+    SilencedStdout() : saved(cout.rdbuf(nullptr)) {}
+    ~SilencedStdout()
+    {
+        cout.rdbuf(saved);
+        cout.clear();
+    }
+};
+
+// Nearest-rank percentile of an ascending sample.
+double percentileMs(const vector<double> &sorted, double percent)
+{
+    if (sorted.empty())
+        return 0.0;
+    size_t rank = (size_t)ceil(percent / 100.0 * sorted.size());
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+size_t activeStoreBytes()
+{
+    size_t total = 0;
+    visitChannelStores([&](auto &stores)
+                       {
+        for (auto *store : stores)
+            total += store->footprintBytes(); });
+    return total;
+}
+
+// Opens a measurement window on the counted store allocations: from here
+// on their peak is the stage's own.
+void resetStoreAllocationPeaks()
+{
+    visitChannelStores([&](auto &stores)
+                       {
+        for (auto *store : stores)
+            store->resetAllocationPeak(); });
+}
+
+void readStoreAllocations(long long &live, long long &peak)
+{
+    live = peak = 0;
+    visitChannelStores([&](auto &stores)
+                       {
+        for (auto *store : stores)
+        {
+            live += store->getAllocations().liveBytes();
+            peak += store->getAllocations().peakBytes();
+        } });
+}
+
+// Runs setup (untimed) and then pass (timed) repeats times.
+template <typename Setup, typename Pass>
+StageResult runStage(const string &mode, const string &stage, int repeats, Setup setup, Pass pass)
+{
+    StageResult result;
+    result.mode = mode;
+    result.stage = stage;
+    resetStoreAllocationPeaks();
+    for (int r = 0; r < repeats; ++r)
+    {
+        SilencedStdout silence;
+        setup();
+        auto begin = high_resolution_clock::now();
+        pass();
+        result.ms.push_back(duration<double, milli>(high_resolution_clock::now() - begin).count());
+    }
+    result.memory = readProcessMemory();
+    readStoreAllocations(result.allocatedBytes, result.peakAllocatedBytes);
+    result.storeBytes = activeStoreBytes();
+
+    vector<double> sorted = result.ms;
+    sort(sorted.begin(), sorted.end());
+    cerr << "[bench] " << left << setw(9) << mode << " " << setw(BENCHMARK_STAGE_WIDTH) << stage << " " << right
+         << fixed << setprecision(2) << "median " << setw(10) << percentileMs(sorted, 50) << " ms\n";
+    return result;
+}
+
+// Times every load, search, sort and export path of one mode on csv.
+void benchmarkMode(const string &mode, const string &csv, const BenchmarkOptions &options, vector<StageResult> &results)
+{
+    bool synthetic = options.csv.empty();
+    isLinkedMode = (mode == "linked");
+    isColumnarMode = (mode == "columnar");
+    // The bench keeps its own snapshot, so a cache next to a user's CSV is
+    // never read, replaced or deleted.
+    string snapshotPath = (filesystem::temp_directory_path() / ("bench_" + mode + ".snapshot")).string();
+    auto noSetup = [] {};
+
+    results.push_back(runStage(mode, "load_csv", options.repeats, noSetup, [&]
+                               { loadData(csv, ""); }));
+    uint64_t sourceSize = 0;
+    int64_t sourceModified = 0;
+    if (sourceFileStamp(csv, sourceSize, sourceModified))
+        results.push_back(runStage(mode, "save_snapshot", options.repeats, noSetup, [&]
+                                   { saveSnapshot(snapshotPath, sourceSize, sourceModified); }));
+    if (synthetic)
+    {
+        SyntheticDataGenerator generator(options.data);
+        results.push_back(runStage(mode, "load_synthetic", options.repeats, noSetup, [&]
+                                   { loadSyntheticData(generator); }));
+    }
+    results.push_back(runStage(mode, "load_snapshot", options.repeats, noSetup, [&]
+                               { loadData(csv, snapshotPath); }));
+
+    const string term = "transfer";
+    vector<char> matches = matchingTransactionTypes(term);
+    int targetCode = fieldDictionaries.transactionType.find(term);
+    SortSpec byLocation{{SORT_KEY_LOCATION, true}};
+    SortSpec byType{{SORT_KEY_TRANSACTION_TYPE, true}};
+    vector<pair<string, SortAlgorithm>> sorts = {{"sort_bucket", SORT_BUCKET}, {"sort_quick", SORT_QUICK}, {"sort_merge", SORT_MERGE}, {"sort_radix", SORT_RADIX}};
+    filesystem::path exportPrefix = filesystem::temp_directory_path() / ("bench_" + mode);
+
+    visitChannelStores([&](auto &stores)
+                       {
+        using Store = remove_reference_t<decltype(*stores[0])>;
+        constexpr bool isList = is_same_v<Store, LinkedListTransactionStore>;
+        CursorFor<Store> cursors[4];
+
+        results.push_back(runStage(mode, "linear_search", options.repeats, noSetup, [&]
+                                   { collectTypeMatches(stores, matches, cursors); }));
+
+        // Every sort starts from insertion order.
+        for (auto &[stage, algorithm] : sorts)
+        {
+            // Lists have no random access for a quick sort.
+            if (isList && algorithm == SORT_QUICK)
+                continue;
+            results.push_back(runStage(mode, stage, options.repeats, [&]
+                                       { sortStores(stores, byLocation, algorithm, true); },
+                                       [&]
+                                       { sortStores(stores, byLocation, algorithm, false); }));
+        }
+
+        sortStores(stores, byType, SORT_BUCKET, false);
+        results.push_back(runStage(mode, "binary_search", options.repeats, noSetup, [&]
+                                   { collectTypeRange(stores, targetCode, cursors); }));
+        sortStores(stores, byType, SORT_BUCKET, true);
+
+        vector<NumericPredicate> predicates;
+        string error;
+        parseNumericPredicates("amount > 1000 and geo_anomaly_score > 0.8 and is_fraud", predicates, error);
+        // Packing the array and list columns is a one-off per load, not part
+        // of a filter, so it happens before the clock starts.
+        auto packColumns = [&]
+        {
+            for (auto *store : stores)
+                store->getNumericColumns();
+        };
+        results.push_back(runStage(mode, "numeric_filter", options.repeats, packColumns, [&]
+                                   { collectFilterMatches(stores, predicates, cursors); }));
+        results.push_back(runStage(mode, "numeric_filter_scalar", options.repeats, packColumns, [&]
+                                   { collectFilterMatches(stores, predicates, cursors, filterDoublesScalar, filterFlagsScalar); }));
+
+        results.push_back(runStage(mode, "aggregate_location", options.repeats, noSetup, [&]
+                                   { aggregateStores(stores, GROUP_BY_LOCATION); }));
+
+        results.push_back(runStage(mode, "export_json", options.repeats, noSetup, [&]
+                                   { exportChannels(exportPrefix.string(), stores, EXPORT_JSON_PRETTY); }));
+        for (const char *channel : {"card", "ach", "upi", "wire"})
+            filesystem::remove(exportPrefix.string() + "_" + channel + exportFileExtension(EXPORT_JSON_PRETTY)); });
+
+    filesystem::remove(snapshotPath);
+    clearAllStores();
+    fieldDictionaries.clear();
+}
+
+// Runs every stage of every requested mode and writes one JSON document with
+// min/median/p99 wall time and memory per stage to options.out, or stdout.
+int runHeadlessBenchmark(const BenchmarkOptions &options)
+{
+    string csv = options.csv;
+    bool synthetic = csv.empty();
+    if (synthetic)
+    {
+        csv = (filesystem::temp_directory_path() / ("bench_" + to_string(options.data.rows) + "_" + to_string(options.data.seed) + ".csv")).string();
+        cerr << "[bench] Generating " << options.data.rows << " synthetic rows (seed " << options.data.seed << ")\n";
+        if (!SyntheticDataGenerator(options.data).writeCsv(csv, ingestThreadCount()))
+        {
+            cerr << "Could not write " << csv << "\n";
+            return 1;
+        }
+    }
+    else if (!filesystem::exists(csv))
+    {
+        cerr << "Error opening file.\n";
+        return 1;
+    }
+
+    vector<StageResult> results;
+    for (const string &mode : options.modes)
+        benchmarkMode(mode, csv, options, results);
+    if (synthetic)
+        filesystem::remove(csv);
+
+    nlohmann::ordered_json report;
+    report["dataset"] = synthetic ? "synthetic" : csv;
+    if (synthetic)
+    {
+        report["rows"] = options.data.rows;
+        report["seed"] = options.data.seed;
+        report["cardinality"] = {{"location", options.data.locations},
+                                 {"transaction_type", options.data.transactionTypes},
+                                 {"payment_channel", options.data.paymentChannels}};
+    }
+    else
+    {
+        // The row count of a given CSV is whatever each mode loaded.
+        report["rows"] = nullptr;
+    }
+    report["repeats"] = options.repeats;
+    report["threads"] = ingestThreadCount();
+    report["results"] = nlohmann::ordered_json::array();
+    for (const StageResult &result : results)
+    {
+        vector<double> sorted = result.ms;
+        sort(sorted.begin(), sorted.end());
+        nlohmann::ordered_json entry;
+        entry["mode"] = result.mode;
+        entry["stage"] = result.stage;
+        entry["runs"] = result.ms;
+        entry["min_ms"] = sorted.front();
+        entry["median_ms"] = percentileMs(sorted, 50);
+        entry["p99_ms"] = percentileMs(sorted, 99);
+        entry["rss_mb"] = result.memory.rssMB;
+        entry["peak_rss_mb"] = result.memory.peakRssMB;
+        entry["store_alloc_mb"] = result.allocatedBytes / (1024.0 * 1024.0);
+        entry["store_alloc_peak_mb"] = result.peakAllocatedBytes / (1024.0 * 1024.0);
+        entry["store_bytes"] = result.storeBytes;
+        report["results"].push_back(entry);
+    }
+
+    string text = report.dump(2) + "\n";
+    if (options.out.empty())
+    {
+        cout << text;
+        return 0;
+    }
+    ofstream out(options.out, ios::out | ios::binary);
+    out << text;
+    if (!out.good())
+    {
+        cerr << "Could not write " << options.out << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+// Options shared by everything that generates data; the usage line lists
+// them after the command's own.
+const char *SYNTHETIC_OPTIONS_USAGE = " [--rows N] [--seed S] [--locations L] [--types T] [--channels C]"
+                                      " [--fraud-rate F] [--missing-channel-rate M]";
+
+// Consumes the generator option at argv[i] and its value; false when argv[i]
+// is not one.
+bool parseSyntheticOption(int argc, char *argv[], int &i, SyntheticDataSpec &spec)
+{
+    if (i + 1 >= argc)
+        return false;
+    string arg = argv[i];
+    const char *value = argv[i + 1];
+    if (arg == "--rows")
+        spec.rows = atoll(value);
+    else if (arg == "--seed")
+        spec.seed = strtoull(value, nullptr, 10);
+    else if (arg == "--locations")
+        spec.locations = atoi(value);
+    else if (arg == "--types")
+        spec.transactionTypes = atoi(value);
+    else if (arg == "--channels")
+        spec.paymentChannels = atoi(value);
+    else if (arg == "--fraud-rate")
+        spec.fraudRate = atof(value);
+    else if (arg == "--missing-channel-rate")
+        spec.missingChannelRate = atof(value);
+    else
+        return false;
+    ++i;
+    return true;
+}
+
+// Stores index rows with int, which bounds the row count.
+bool validSyntheticSpec(const SyntheticDataSpec &spec)
+{
+    return spec.rows >= 1 && spec.rows <= INT_MAX &&
+           spec.locations >= 1 && spec.transactionTypes >= 1 && spec.paymentChannels >= 1 &&
+           spec.fraudRate >= 0.0 && spec.fraudRate <= 1.0 &&
+           spec.missingChannelRate >= 0.0 && spec.missingChannelRate <= 1.0;
+}
+
+// Parses the arguments following --bench; false (after printing usage) on
+// anything it does not understand.
+bool parseBenchmarkOptions(int argc, char *argv[], BenchmarkOptions &options)
+{
+    bool understood = true;
+    for (int i = 2; i < argc; ++i)
+    {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (parseSyntheticOption(argc, argv, i, options.data))
+            continue;
+        if (arg == "--repeats" && hasValue)
+            options.repeats = atoi(argv[++i]);
+        else if (arg == "--csv" && hasValue)
+            options.csv = argv[++i];
+        else if (arg == "--out" && hasValue)
+            options.out = argv[++i];
+        else if (arg == "--modes" && hasValue)
+        {
+            options.modes.clear();
+            string list = argv[++i];
+            for (size_t begin = 0; begin <= list.size();)
+            {
+                size_t end = list.find(',', begin);
+                if (end == string::npos)
+                    end = list.size();
+                options.modes.push_back(list.substr(begin, end - begin));
+                begin = end + 1;
+            }
+        }
+        else
+            understood = false;
+    }
+
+    bool validModes = !options.modes.empty();
+    for (const string &mode : options.modes)
+        validModes = validModes && (mode == "array" || mode == "linked" || mode == "columnar");
+    if (!understood || !validSyntheticSpec(options.data) || options.repeats < 1 || !validModes)
+    {
+        cerr << "Usage: " << argv[0] << " --bench [--repeats R] [--modes array,linked,columnar]"
+             << " [--csv path] [--out file]" << SYNTHETIC_OPTIONS_USAGE << "\n";
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1 && string(argv[1]) == "--bench-parser")
+    {
+        runParserBenchmark(argc > 2 ? argv[2] : "financial_fraud_detection.csv");
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-sort")
+    {
+        runSortBenchmark(argc > 2 ? atoi(argv[2]) : 500000);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench")
+    {
+        BenchmarkOptions options;
+        if (!parseBenchmarkOptions(argc, argv, options))
+            return 1;
+        return runHeadlessBenchmark(options);
+    }
+    if (argc > 2 && string(argv[1]) == "--generate")
+    {
+        SyntheticDataSpec spec;
+        bool understood = true;
+        for (int i = 3; i < argc && understood; ++i)
+            understood = parseSyntheticOption(argc, argv, i, spec);
+        if (!understood || !validSyntheticSpec(spec))
+        {
+            cerr << "Usage: " << argv[0] << " --generate <file.csv>" << SYNTHETIC_OPTIONS_USAGE << "\n";
+            return 1;
+        }
+        auto start = high_resolution_clock::now();
+        if (!SyntheticDataGenerator(spec).writeCsv(argv[2], ingestThreadCount()))
+        {
+            cerr << "Could not write " << argv[2] << "\n";
+            return 1;
+        }
+        cout << "Generated " << spec.rows << " rows to " << argv[2] << " in "
+             << duration_cast<milliseconds>(high_resolution_clock::now() - start).count() << " ms\n";
+        return 0;
+    }
+
+    // The interactive program reads financial_fraud_detection.csv unless
+    // given another CSV or asked to generate its data.
+    string csvPath = "financial_fraud_detection.csv";
+    bool synthetic = false;
+    SyntheticDataSpec spec;
+    bool understood = true;
+    for (int i = 1; i < argc && understood; ++i)
+    {
+        string arg = argv[i];
+        if (arg == "--csv" && i + 1 < argc)
+            csvPath = argv[++i];
+        else if (arg == "--synthetic")
+            synthetic = true;
+        else
+            understood = parseSyntheticOption(argc, argv, i, spec);
+    }
+    if (!understood || !validSyntheticSpec(spec))
+    {
+        cerr << "Usage: " << argv[0] << " [--csv path | --synthetic" << SYNTHETIC_OPTIONS_USAGE << "]\n"
+             << "       " << argv[0] << " --generate <file.csv>" << SYNTHETIC_OPTIONS_USAGE << "\n"
+             << "       " << argv[0] << " --bench [options] | --bench-sort [rows] | --bench-parser [file]\n";
+        return 1;
+    }
+
     int mode;
     while (true)
     {
@@ -1280,21 +2727,26 @@ int main()
         cout << "|   Choose mode:              |\n";
         cout << "|   1 = Array                 |\n";
         cout << "|   2 = Linked List           |\n";
+        cout << "|   3 = Columnar              |\n";
         cout << "-------------------------------\n";
         cout << "Enter your choice: ";
         cin >> mode;
-        if (cin.fail() || (mode != 1 && mode != 2))
+        if (cin.fail() || (mode != 1 && mode != 2 && mode != 3))
         {
             cin.clear();
             cin.ignore();
-            cout << "Invalid input. Please enter pick between Array or Linked List.\n";
+            cout << "Invalid input. Please enter pick between Array, Linked List or Columnar.\n";
             continue;
         }
         break;
     }
     isLinkedMode = (mode == 2);
+    isColumnarMode = (mode == 3);
 
-    loadData("financial_fraud_detection.csv");
+    if (synthetic)
+        loadSyntheticData(SyntheticDataGenerator(spec));
+    else
+        loadData(csvPath);
 
     int mainChoice;
     do
@@ -1319,28 +2771,18 @@ int main()
             handleSortMenu();
             break;
         case 3:
-            if (isLinkedMode)
-            {
-                exportLinkedListToJSON("linked_card.json", cardLL);
-                exportLinkedListToJSON("linked_ach.json", achLL);
-                exportLinkedListToJSON("linked_upi.json", upiLL);
-                exportLinkedListToJSON("linked_wire.json", wireLL);
-            }
-            else
-            {
-                exportStoreToJSON("array_card.json", cardStore);
-                exportStoreToJSON("array_ach.json", achStore);
-                exportStoreToJSON("array_upi.json", upiStore);
-                exportStoreToJSON("array_wire.json", wireStore);
-            }
+            handleExportMenu();
             break;
         case 4:
+            handleAnalyticsMenu();
+            break;
+        case 5:
             cout << "Exiting program.\n";
             break;
         default:
             cout << "Invalid choice. Try again.\n";
         }
-    } while (mainChoice != 4);
+    } while (mainChoice != 5);
 
     return 0;
 }